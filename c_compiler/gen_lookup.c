@@ -5,6 +5,7 @@
 #include "gen_lookup.h"
 #include "icdf.h"
 #include "yaml_parse.h"
+#include "templ.h"
 
 int gen_lookup_c0(const RngData *rng_data, by_t *buffer, by_t *max_out)
 {
@@ -140,20 +141,82 @@ int gen_lookup_c1(const RngData *rng_data, by_t *c0, by_t max_out, by_t *c1)
 int gen_lookup_save_cx(const char *const filename, by_t *cx, size_t len)
 {
     int rtn = 0;
-    FILE *file = fopen(filename,"w");
-    if(!file)
+
+    const char template_file[] = "templates/templ_cx.mem";
+
+    TemplDict *dict = templ_dict_new();
+    for(size_t i = 0; i < len; i++)
     {
-        printf("Failed to create file '%s'", filename);
-        // return 1;
-        exit(EXIT_FAILURE);
+        TemplDict *entry = templ_dict_add_item(dict, "ENTRIES");
+        templ_dict_set_hex(entry, "VALUE", cx[i]);
     }
 
-    for(size_t i = 0; i < len; i++)
+    rtn += templ_render(template_file, filename, dict);
+    templ_dict_free(dict);
+
+    return rtn;
+}
+
+int gen_lookup_save_tb(const char *const filename, const RngData *rng_data, by_t *c0, by_t *c1)
+{
+    int rtn = 0;
+
+    const char template_file[] = "templates/templ_rng_lookup_tb.v";
+
+    section_t num_sect = yaml_parse_num_sections(rng_data);
+    subsection_t num_subsect = yaml_parse_num_subsections(rng_data);
+    subsection_t stride = (num_subsect + GEN_LOOKUP_TB_MAX_SUBSECTIONS - 1) / GEN_LOOKUP_TB_MAX_SUBSECTIONS;
+
+    TemplDict *dict = templ_dict_new();
+    templ_dict_set_int(dict, "BY", rng_data->BY);
+    for(section_t sect = 0; sect < num_sect; sect++)
     {
-        rtn += fprintf(file, "%llx\n", cx[i]);
+        TemplDict *section = templ_dict_add_item(dict, "SECTIONS");
+        templ_dict_set_int(section, "SECTION", sect);
+        for(subsection_t subsect = 0; subsect < num_subsect; subsect += stride)
+        {
+            size_t i = (size_t)sect * num_subsect + subsect;
+            TemplDict *subsection = templ_dict_add_item(section, "SUBSECTIONS");
+            templ_dict_set_int(subsection, "SUBSECTION", (long long)subsect);
+            templ_dict_set_hex(subsection, "C0", c0[i]);
+            templ_dict_set_hex(subsection, "C1", c1[i]);
+        }
     }
 
-    fclose(file);
-    printf("Generated file \"%s\"\n", filename);
-    return 0;
+    rtn += templ_render(template_file, filename, dict);
+    templ_dict_free(dict);
+
+    return rtn;
+}
+
+int gen_lookup_use_lut(const RngData *rng_data)
+{
+    size_t len = (size_t)yaml_parse_num_sections(rng_data) * yaml_parse_num_subsections(rng_data);
+    return len <= GEN_LOOKUP_LUT_MAX_LEN;
+}
+
+int gen_lookup_save_lut(const char *const filename, const RngData *rng_data, by_t *c0, by_t *c1, size_t len)
+{
+    int rtn = 0;
+
+    const char template_file[] = "templates/templ_lookup.vh";
+
+    TemplDict *dict = templ_dict_new();
+    templ_dict_set_int(dict, "BY", rng_data->BY);
+
+    // ROM lookup does not include the table, only write a stub so the file always exists
+    int use_lut = gen_lookup_use_lut(rng_data);
+    templ_dict_set_int(dict, "LOOKUP_LUT", use_lut);
+    for(size_t i = 0; use_lut && i < len; i++)
+    {
+        TemplDict *entry = templ_dict_add_item(dict, "ENTRIES");
+        templ_dict_set_int(entry, "ADDR", (long long)i);
+        templ_dict_set_hex(entry, "C0", c0[i]);
+        templ_dict_set_hex(entry, "C1", c1[i]);
+    }
+
+    rtn += templ_render(template_file, filename, dict);
+    templ_dict_free(dict);
+
+    return rtn;
 }
\ No newline at end of file
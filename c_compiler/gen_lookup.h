@@ -3,6 +3,12 @@
 #include <stddef.h>
 #include "yaml_parse.h"
 
+// Lookup tables with this many entries or fewer are emitted as combinational logic instead of ROMs
+#define GEN_LOOKUP_LUT_MAX_LEN 64
+
+// Testbench checks at most this many subsections per section, evenly spaced
+#define GEN_LOOKUP_TB_MAX_SUBSECTIONS 16
+
 /* Generate c0 coefficients for lookup table
  *
  * rng_data -- pointer to RNG data from YAML file
@@ -27,4 +33,30 @@ int gen_lookup_c1(const RngData *rng_data, by_t *c0, by_t max_out, by_t *c1);
  */
 int gen_lookup_save_cx(const char *const filename, by_t *cx, size_t len);
 
+/* Return nonzero if lookup table is small enough to be emitted as combinational logic
+ *
+ * rng_data -- pointer to RNG data from YAML file
+ */
+int gen_lookup_use_lut(const RngData *rng_data);
+
+/* Save c0 and c1 arrays to file as Verilog case statement items, indexed by lookup address
+ * Only a stub is written when the lookup table is too large for combinational logic.
+ *
+ * filename -- path to file
+ * rng_data -- pointer to RNG data from YAML file
+ * c0       -- pointer to filled c0 array
+ * c1       -- pointer to filled c1 array
+ * len      -- number of elements in arrays c0 and c1
+ */
+int gen_lookup_save_lut(const char *const filename, const RngData *rng_data, by_t *c0, by_t *c1, size_t len);
+
+/* Save rng_lookup testbench checking the lookup module output against c0 and c1 arrays for every section
+ *
+ * filename -- path to file
+ * rng_data -- pointer to RNG data from YAML file
+ * c0       -- pointer to filled c0 array
+ * c1       -- pointer to filled c1 array
+ */
+int gen_lookup_save_tb(const char *const filename, const RngData *rng_data, by_t *c0, by_t *c1);
+
 #endif //_GEN_LOOKUP_H_
@@ -3,52 +3,8 @@
 #include <string.h>
 #include "gen_vh.h"
 #include "yaml_parse.h"
-
-#define FLAG 35  // '#' character
-
-int gen_file(const char *src, const char *dest, int flag, const char *data)
-{
-    /* Copy contents of source file to destination file, replacing flag with relevant data
-     * src  -- source file path
-     * dest -- destination file path
-     * flag -- ASCII character to replace with data
-     * data -- string to insert in place of flag
-     */
-    FILE *src_file = fopen(src,"r");
-    if(!src_file)
-    {
-        printf("Failed to open source file '%s'\n", src);
-        //return 1;
-        exit(EXIT_FAILURE);
-    }
-
-    FILE *dest_file = fopen(dest,"w");
-    if(!dest_file)
-    {
-        printf("Failed to create destination file '%s'\n", dest);
-        //return 1;
-        exit(EXIT_FAILURE);
-    }
-
-    int c;
-    while ((c = fgetc(src_file)) != EOF)
-    {
-        if(c==flag)
-        {
-            fputs(data, dest_file);
-        }
-        else
-        {
-            fputc(c, dest_file);
-        }
-    }
-
-    fclose (src_file);
-    fclose (dest_file);
-
-    printf("Generated file \"%s\"\n", dest);
-    return 0;
-}
+#include "gen_lookup.h"
+#include "templ.h"
 
 int gen_vh_rng(const char *destination, const RngData *const rng_data)
 {
@@ -56,45 +12,19 @@ int gen_vh_rng(const char *destination, const RngData *const rng_data)
 
     const char template_file[] = "templates/templ_rng.vh";
 
-    // Determine length of required buffer
-    int len = snprintf(NULL, 0,
-            "`define RNG_BY %d\n"
-            "`define RNG_K %d\n"
-            "`define RNG_MANT_BW %d\n"
-            "`define RNG_EXP_BW %d\n"
-            "`define RNG_MAX_G_D %d\n"
-            "`define RNG_SEC_ADDR_SIZE %d\n"
-            "`define RNG_GROWING_OCT %d\n"
-            "`define RNG_DIMINISHING_OCT %d",
-            rng_data->BY,
-            rng_data->K,
-            rng_data->MANT_BW,
-            rng_data->EXP_BW,
-            rng_data->MAX_G_D,
-            rng_data->SEC_ADDR_SIZE,
-            rng_data->GROWING_OCT,
-            rng_data->DIMINISHING_OCT);
-
-    char data[len+1];
-    snprintf(data, len+1,
-             "`define RNG_BY %d\n"
-             "`define RNG_K %d\n"
-             "`define RNG_MANT_BW %d\n"
-             "`define RNG_EXP_BW %d\n"
-             "`define RNG_MAX_G_D %d\n"
-             "`define RNG_SEC_ADDR_SIZE %d\n"
-             "`define RNG_GROWING_OCT %d\n"
-             "`define RNG_DIMINISHING_OCT %d",
-             rng_data->BY,
-             rng_data->K,
-             rng_data->MANT_BW,
-             rng_data->EXP_BW,
-             rng_data->MAX_G_D,
-             rng_data->SEC_ADDR_SIZE,
-             rng_data->GROWING_OCT,
-             rng_data->DIMINISHING_OCT);
-
-    rtn += gen_file(template_file, destination, FLAG, data);
+    TemplDict *dict = templ_dict_new();
+    templ_dict_set_int(dict, "BY", rng_data->BY);
+    templ_dict_set_int(dict, "K", rng_data->K);
+    templ_dict_set_int(dict, "MANT_BW", rng_data->MANT_BW);
+    templ_dict_set_int(dict, "EXP_BW", rng_data->EXP_BW);
+    templ_dict_set_int(dict, "MAX_G_D", rng_data->MAX_G_D);
+    templ_dict_set_int(dict, "SEC_ADDR_SIZE", rng_data->SEC_ADDR_SIZE);
+    templ_dict_set_int(dict, "GROWING_OCT", rng_data->GROWING_OCT);
+    templ_dict_set_int(dict, "DIMINISHING_OCT", rng_data->DIMINISHING_OCT);
+    templ_dict_set_int(dict, "LOOKUP_LUT", gen_lookup_use_lut(rng_data));
+
+    rtn += templ_render(template_file, destination, dict);
+    templ_dict_free(dict);
 
     return rtn;
 }
@@ -105,17 +35,44 @@ int gen_vh_urng(const char *destination, const UrngData *const urng_data)
 
     const char template_file[] = "templates/templ_urng.vh";
 
-    // Determine length of required buffer
-    int len = snprintf(NULL, 0,
-                       "`define URNG_BX %d\n",
-                       urng_data->BX);
+    TemplDict *dict = templ_dict_new();
+    templ_dict_set_int(dict, "BX", urng_data->BX);
+
+    rtn += templ_render(template_file, destination, dict);
+    templ_dict_free(dict);
+
+    return rtn;
+}
+
+int gen_vh_sensor(const char *destination, const SensorData *const sensor_data)
+{
+    int rtn = 0;
 
-    char data[len+1];
-    snprintf(data, len+1,
-             "`define URNG_BX %d\n",
-             urng_data->BX);
+    const char template_file[] = "templates/templ_sensor.vh";
 
-    rtn += gen_file(template_file, destination, FLAG, data);
+    TemplDict *dict = templ_dict_new();
+    templ_dict_set_int(dict, "BW", sensor_data->BW);
+    templ_dict_set_int(dict, "MIN", sensor_data->MIN);
+    templ_dict_set_int(dict, "MAX", sensor_data->MAX);
+
+    rtn += templ_render(template_file, destination, dict);
+    templ_dict_free(dict);
 
     return rtn;
-}
\ No newline at end of file
+}
+
+int gen_vh_fifo(const char *destination, const FifoData *const fifo_data)
+{
+    int rtn = 0;
+
+    const char template_file[] = "templates/templ_fifo.vh";
+
+    TemplDict *dict = templ_dict_new();
+    templ_dict_set_int(dict, "DEPTH", fifo_data->DEPTH);
+    templ_dict_set_int(dict, "ADDR_BW", fifo_data->ADDR_BW);
+
+    rtn += templ_render(template_file, destination, dict);
+    templ_dict_free(dict);
+
+    return rtn;
+}
@@ -17,4 +17,18 @@ int gen_vh_rng(const char *destination, const RngData *const rng_data);
  */
 int gen_vh_urng(const char *destination, const UrngData *const urng_data);
 
+/* Generate .vh file containing sensor query datapath parameters
+ *
+ * destination -- path to destination .vh file
+ * sensor_data -- sensor data from YAML file
+ */
+int gen_vh_sensor(const char *destination, const SensorData *const sensor_data);
+
+/* Generate .vh file containing noise prefetch FIFO parameters
+ *
+ * destination -- path to destination .vh file
+ * fifo_data   -- noise prefetch FIFO data from YAML file
+ */
+int gen_vh_fifo(const char *destination, const FifoData *const fifo_data);
+
 #endif //_GEN_VH_H_
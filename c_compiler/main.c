@@ -18,10 +18,15 @@ int main(int argc, char **argv) {
     const char filename[] = "privacy.yaml";
     UrngData urng_data;
     RngData rng_data;
-    rtn += yaml_parse_parse(filename, &urng_data, &rng_data);
+    SensorData sensor_data = {0};
+    FifoData fifo_data = {0};
+    rtn += yaml_parse_parse(filename, &urng_data, &rng_data, &sensor_data, &fifo_data);
+    rtn += yaml_parse_derive_fifo(&urng_data, &rng_data, &fifo_data, gen_lookup_use_lut(&rng_data));
 
     rtn += gen_vh_urng("verilog/urng.vh", &urng_data);
     rtn += gen_vh_rng("verilog/rng.vh", &rng_data);
+    rtn += gen_vh_sensor("verilog/sensor.vh", &sensor_data);
+    rtn += gen_vh_fifo("verilog/fifo.vh", &fifo_data);
 
     /* Generate lookup table entries */
     section_t num_sect = yaml_parse_num_sections(&rng_data);
@@ -37,6 +42,8 @@ int main(int argc, char **argv) {
 
     rtn += gen_lookup_save_cx("verilog/c0.mem", c0, len);
     rtn += gen_lookup_save_cx("verilog/c1.mem", c1, len);
+    rtn += gen_lookup_save_lut("verilog/lookup.vh", &rng_data, c0, c1, len);
+    rtn += gen_lookup_save_tb("verilog/rng_lookup_tb.v", &rng_data, c0, c1);
 
 //    for(size_t i = 0; i < len; i++)
 //    {
@@ -0,0 +1,498 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "templ.h"
+
+#define TEMPL_MAX_DEPTH 32  // Maximum section nesting depth
+#define TEMPL_OPEN "<%"     // Tag delimiters, chosen not to clash with Verilog {{}} replication
+#define TEMPL_CLOSE "%>"
+#define TEMPL_DELIM_LEN 2
+
+typedef struct templ_entry
+{
+    char *key;
+    char *value;            // NULL for lists
+    TemplDict **items;      // List items
+    size_t num_items;
+    size_t cap_items;
+}Templ_entry;
+
+struct templ_dict
+{
+    const TemplDict *parent;  // Enclosing dictionary, searched if key is not found
+    Templ_entry *entries;
+    size_t num_entries;
+    size_t cap_entries;
+};
+
+typedef enum templ_node_type
+{
+    NODE_TEXT,
+    NODE_VAR,
+    NODE_SECTION,
+    NODE_INVERTED
+}Templ_node_type;
+
+typedef struct templ_node
+{
+    Templ_node_type type;
+    const char *str;  // Text, or NUL terminated placeholder name
+    size_t len;       // Length of text
+    size_t end;       // Sections only: index of first node after section body
+}Templ_node;
+
+typedef struct templ
+{
+    const char *path;
+    char *src;          // Template source, placeholder names are NUL terminated in place
+    Templ_node *nodes;
+    size_t num_nodes;
+}Templ;
+
+typedef struct templ_buffer
+{
+    char *data;
+    size_t len;
+    size_t cap;
+}Templ_buffer;
+
+void *templ_alloc(void *ptr, size_t size)
+{
+    /* realloc, exiting on failure
+     *
+     * ptr  -- existing allocation or NULL
+     * size -- new size in bytes
+     */
+    void *rtn = realloc(ptr, size);
+    if(!rtn)
+    {
+        printf("Out of memory\n");
+        exit(EXIT_FAILURE);
+    }
+    return rtn;
+}
+
+char *templ_strdup(const char *str)
+{
+    size_t len = strlen(str);
+    char *rtn = templ_alloc(NULL, len + 1);
+    memcpy(rtn, str, len + 1);
+    return rtn;
+}
+
+void templ_buffer_append(Templ_buffer *buf, const char *str, size_t len)
+{
+    /* Append len characters of str to buffer, growing it geometrically
+     *
+     * buf -- output buffer
+     * str -- characters to append
+     * len -- number of characters to append
+     */
+    if(buf->len + len > buf->cap)
+    {
+        size_t cap = buf->cap ? buf->cap : 4096;
+        while(cap < buf->len + len)
+        {
+            cap *= 2;
+        }
+        buf->data = templ_alloc(buf->data, cap);
+        buf->cap = cap;
+    }
+    memcpy(buf->data + buf->len, str, len);
+    buf->len += len;
+}
+
+TemplDict *templ_dict_new(void)
+{
+    TemplDict *dict = templ_alloc(NULL, sizeof(TemplDict));
+    dict->parent = NULL;
+    dict->entries = NULL;
+    dict->num_entries = 0;
+    dict->cap_entries = 0;
+    return dict;
+}
+
+void templ_dict_free(TemplDict *dict)
+{
+    if(!dict)
+    {
+        return;
+    }
+    for(size_t i = 0; i < dict->num_entries; i++)
+    {
+        Templ_entry *entry = &dict->entries[i];
+        for(size_t j = 0; j < entry->num_items; j++)
+        {
+            templ_dict_free(entry->items[j]);
+        }
+        free(entry->items);
+        free(entry->value);
+        free(entry->key);
+    }
+    free(dict->entries);
+    free(dict);
+}
+
+Templ_entry *templ_dict_find(const TemplDict *dict, const char *key)
+{
+    /* Return entry in dict (not its parents) with matching key, or NULL
+     *
+     * dict -- dictionary to search
+     * key  -- placeholder name
+     */
+    for(size_t i = 0; i < dict->num_entries; i++)
+    {
+        if(strcmp(dict->entries[i].key, key) == 0)
+        {
+            return &dict->entries[i];
+        }
+    }
+    return NULL;
+}
+
+const Templ_entry *templ_dict_lookup(const TemplDict *dict, const char *key)
+{
+    /* Return entry with matching key from dict or its enclosing dictionaries, or NULL
+     *
+     * dict -- innermost dictionary to search
+     * key  -- placeholder name
+     */
+    for(; dict; dict = dict->parent)
+    {
+        Templ_entry *entry = templ_dict_find(dict, key);
+        if(entry)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+Templ_entry *templ_dict_entry(TemplDict *dict, const char *key)
+{
+    /* Return entry in dict with matching key, creating it if necessary
+     *
+     * dict -- dictionary to search
+     * key  -- placeholder name
+     */
+    Templ_entry *entry = templ_dict_find(dict, key);
+    if(entry)
+    {
+        return entry;
+    }
+
+    if(dict->num_entries == dict->cap_entries)
+    {
+        dict->cap_entries = dict->cap_entries ? 2 * dict->cap_entries : 8;
+        dict->entries = templ_alloc(dict->entries, dict->cap_entries * sizeof(Templ_entry));
+    }
+    entry = &dict->entries[dict->num_entries++];
+    entry->key = templ_strdup(key);
+    entry->value = NULL;
+    entry->items = NULL;
+    entry->num_items = 0;
+    entry->cap_items = 0;
+    return entry;
+}
+
+void templ_dict_set_str(TemplDict *dict, const char *key, const char *value)
+{
+    Templ_entry *entry = templ_dict_entry(dict, key);
+    free(entry->value);
+    entry->value = templ_strdup(value);
+}
+
+void templ_dict_set_int(TemplDict *dict, const char *key, long long value)
+{
+    char str[24];
+    snprintf(str, sizeof(str), "%lld", value);
+    templ_dict_set_str(dict, key, str);
+}
+
+void templ_dict_set_hex(TemplDict *dict, const char *key, by_t value)
+{
+    char str[20];
+    snprintf(str, sizeof(str), "%llx", value);
+    templ_dict_set_str(dict, key, str);
+}
+
+TemplDict *templ_dict_add_item(TemplDict *dict, const char *key)
+{
+    Templ_entry *entry = templ_dict_entry(dict, key);
+    if(entry->num_items == entry->cap_items)
+    {
+        entry->cap_items = entry->cap_items ? 2 * entry->cap_items : 8;
+        entry->items = templ_alloc(entry->items, entry->cap_items * sizeof(TemplDict *));
+    }
+    TemplDict *item = templ_dict_new();
+    item->parent = dict;
+    entry->items[entry->num_items++] = item;
+    return item;
+}
+
+void templ_add_node(Templ *templ, size_t *cap, Templ_node_type type, const char *str, size_t len)
+{
+    if(templ->num_nodes == *cap)
+    {
+        *cap = *cap ? 2 * *cap : 64;
+        templ->nodes = templ_alloc(templ->nodes, *cap * sizeof(Templ_node));
+    }
+    Templ_node *node = &templ->nodes[templ->num_nodes++];
+    node->type = type;
+    node->str = str;
+    node->len = len;
+    node->end = 0;
+}
+
+void templ_parse(Templ *templ)
+{
+    /* Split template source into text, placeholder and section nodes
+     *
+     * templ -- template with source loaded
+     */
+    char *src = templ->src;
+    size_t cap = 0;
+    size_t stack[TEMPL_MAX_DEPTH];  // Indices of open section nodes
+    size_t depth = 0;
+    char *pos = src;
+    char *open;
+
+    while((open = strstr(pos, TEMPL_OPEN)) != NULL)
+    {
+        if(open[TEMPL_DELIM_LEN] == '%')
+        {
+            // Escaped opening delimiter, output it literally
+            templ_add_node(templ, &cap, NODE_TEXT, pos, (size_t)(open + TEMPL_DELIM_LEN - pos));
+            pos = open + TEMPL_DELIM_LEN + 1;
+            continue;
+        }
+
+        char *close = strstr(open + TEMPL_DELIM_LEN, TEMPL_CLOSE);
+        if(!close)
+        {
+            printf("Unterminated tag in template '%s'\n", templ->path);
+            exit(EXIT_FAILURE);
+        }
+
+        char sigil = open[TEMPL_DELIM_LEN];
+        int is_section = (sigil == '#' || sigil == '^' || sigil == '/');
+        char *text_end = open;
+        char *next = close + TEMPL_DELIM_LEN;
+
+        if(is_section)
+        {
+            // Tags alone on a line are removed along with the line
+            char *line_start = open;
+            while(line_start > pos && (line_start[-1] == ' ' || line_start[-1] == '\t'))
+            {
+                line_start--;
+            }
+            char *line_end = next;
+            while(*line_end == ' ' || *line_end == '\t')
+            {
+                line_end++;
+            }
+            if((line_start == src || line_start[-1] == '\n') &&
+               (*line_end == '\n' || *line_end == '\0' || (line_end[0] == '\r' && line_end[1] == '\n')))
+            {
+                text_end = line_start;
+                next = line_end + (*line_end == '\r' ? 2 : (*line_end == '\n' ? 1 : 0));
+            }
+        }
+
+        if(text_end > pos)
+        {
+            templ_add_node(templ, &cap, NODE_TEXT, pos, (size_t)(text_end - pos));
+        }
+
+        // Trim and terminate placeholder name in place
+        char *name = open + TEMPL_DELIM_LEN + is_section;
+        while(*name == ' ')
+        {
+            name++;
+        }
+        char *name_end = close;
+        while(name_end > name && name_end[-1] == ' ')
+        {
+            name_end--;
+        }
+        *name_end = '\0';
+
+        switch(sigil)
+        {
+            case '#':
+            case '^':
+                if(depth == TEMPL_MAX_DEPTH)
+                {
+                    printf("Sections nested too deeply in template '%s'\n", templ->path);
+                    exit(EXIT_FAILURE);
+                }
+                stack[depth++] = templ->num_nodes;
+                templ_add_node(templ, &cap, (sigil == '#') ? NODE_SECTION : NODE_INVERTED, name, 0);
+                break;
+            case '/':
+                if(depth == 0 || strcmp(templ->nodes[stack[depth - 1]].str, name) != 0)
+                {
+                    printf("Unmatched section end \"%s\" in template '%s'\n", name, templ->path);
+                    exit(EXIT_FAILURE);
+                }
+                templ->nodes[stack[--depth]].end = templ->num_nodes;
+                break;
+            default:
+                templ_add_node(templ, &cap, NODE_VAR, name, 0);
+                break;
+        }
+        pos = next;
+    }
+
+    if(depth)
+    {
+        printf("Unterminated section \"%s\" in template '%s'\n", templ->nodes[stack[depth - 1]].str, templ->path);
+        exit(EXIT_FAILURE);
+    }
+
+    if(*pos)
+    {
+        templ_add_node(templ, &cap, NODE_TEXT, pos, strlen(pos));
+    }
+}
+
+void templ_free(Templ *templ)
+{
+    free(templ->nodes);
+    free(templ->src);
+    free(templ);
+}
+
+Templ *templ_compile(const char *path)
+{
+    /* Load and parse template file
+     *
+     * path -- template file path
+     */
+    FILE *file = fopen(path, "rb");
+    if(!file)
+    {
+        printf("Failed to open source file '%s'\n", path);
+        exit(EXIT_FAILURE);
+    }
+
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    Templ *templ = templ_alloc(NULL, sizeof(Templ));
+    templ->path = path;
+    templ->src = templ_alloc(NULL, (size_t)size + 1);
+    templ->nodes = NULL;
+    templ->num_nodes = 0;
+
+    size_t len = fread(templ->src, 1, (size_t)size, file);
+    templ->src[len] = '\0';
+    fclose(file);
+
+    templ_parse(templ);
+    return templ;
+}
+
+int templ_is_true(const Templ_entry *entry)
+{
+    if(!entry)
+    {
+        return 0;
+    }
+    if(entry->num_items)
+    {
+        return 1;
+    }
+    return entry->value && entry->value[0] != '\0' && strcmp(entry->value, "0") != 0;
+}
+
+int templ_render_nodes(const Templ *templ, size_t begin, size_t end, const TemplDict *dict, Templ_buffer *buf)
+{
+    /* Render nodes [begin, end) of a compiled template into buffer
+     *
+     * templ -- compiled template
+     * begin -- index of first node
+     * end   -- index after last node
+     * dict  -- values to insert into template
+     * buf   -- output buffer
+     */
+    int rtn = 0;
+    size_t i = begin;
+    while(i < end)
+    {
+        const Templ_node *node = &templ->nodes[i];
+        const Templ_entry *entry;
+        switch(node->type)
+        {
+            case NODE_TEXT:
+                templ_buffer_append(buf, node->str, node->len);
+                i++;
+                break;
+            case NODE_VAR:
+                entry = templ_dict_lookup(dict, node->str);
+                if(!entry || !entry->value)
+                {
+                    printf("Undefined value \"%s\" in template '%s'\n", node->str, templ->path);
+                    rtn += 1;
+                }
+                else
+                {
+                    templ_buffer_append(buf, entry->value, strlen(entry->value));
+                }
+                i++;
+                break;
+            case NODE_SECTION:
+                entry = templ_dict_lookup(dict, node->str);
+                if(entry && entry->num_items)
+                {
+                    for(size_t j = 0; j < entry->num_items; j++)
+                    {
+                        rtn += templ_render_nodes(templ, i + 1, node->end, entry->items[j], buf);
+                    }
+                }
+                else if(templ_is_true(entry))
+                {
+                    rtn += templ_render_nodes(templ, i + 1, node->end, dict, buf);
+                }
+                i = node->end;
+                break;
+            case NODE_INVERTED:
+                entry = templ_dict_lookup(dict, node->str);
+                if(!templ_is_true(entry))
+                {
+                    rtn += templ_render_nodes(templ, i + 1, node->end, dict, buf);
+                }
+                i = node->end;
+                break;
+        }
+    }
+    return rtn;
+}
+
+int templ_render(const char *src, const char *dest, const TemplDict *dict)
+{
+    Templ *templ = templ_compile(src);
+
+    Templ_buffer buf = {
+            .data = NULL,
+            .len = 0,
+            .cap = 0
+    };
+    int rtn = templ_render_nodes(templ, 0, templ->num_nodes, dict, &buf);
+    templ_free(templ);
+
+    FILE *dest_file = fopen(dest,"w");
+    if(!dest_file)
+    {
+        printf("Failed to create destination file '%s'\n", dest);
+        exit(EXIT_FAILURE);
+    }
+    fwrite(buf.data, 1, buf.len, dest_file);
+    fclose(dest_file);
+    free(buf.data);
+
+    printf("Generated file \"%s\"\n", dest);
+    return rtn;
+}
@@ -0,0 +1,69 @@
+#ifndef _TEMPL_H_
+#define _TEMPL_H_
+
+#include "types.h"
+
+/* Template engine used to generate Verilog source
+ *
+ * Template syntax:
+ *   <%NAME%>               -- replaced with value of NAME
+ *   <%#NAME%>...<%/NAME%>  -- repeated for each item in list NAME, or included once if NAME is a nonzero value
+ *   <%^NAME%>...<%/NAME%>  -- included if NAME is undefined, zero, empty or a list with no items
+ *   <%%                    -- literal <%
+ *
+ * Section tags alone on a line do not produce any output for that line. Names are looked up in the current list
+ * item first, then in each enclosing dictionary.
+ */
+
+typedef struct templ_dict TemplDict;
+
+/* Create an empty dictionary of template values
+ */
+TemplDict *templ_dict_new(void);
+
+/* Free dictionary, including any list items added to it
+ *
+ * dict -- dictionary to free
+ */
+void templ_dict_free(TemplDict *dict);
+
+/* Set template value
+ *
+ * dict  -- dictionary to store value within
+ * key   -- placeholder name
+ * value -- string to insert in place of placeholder
+ */
+void templ_dict_set_str(TemplDict *dict, const char *key, const char *value);
+
+/* Set template value in decimal form
+ *
+ * dict  -- dictionary to store value within
+ * key   -- placeholder name
+ * value -- integer to insert in place of placeholder
+ */
+void templ_dict_set_int(TemplDict *dict, const char *key, long long value);
+
+/* Set template value in hex form (without prefix)
+ *
+ * dict  -- dictionary to store value within
+ * key   -- placeholder name
+ * value -- integer to insert in place of placeholder
+ */
+void templ_dict_set_hex(TemplDict *dict, const char *key, by_t value);
+
+/* Append an item to a list, returning the item's dictionary (owned by dict)
+ *
+ * dict -- dictionary to store list within
+ * key  -- list name
+ */
+TemplDict *templ_dict_add_item(TemplDict *dict, const char *key);
+
+/* Render template to destination file
+ *
+ * src  -- template file path
+ * dest -- destination file path
+ * dict -- values to insert into template
+ */
+int templ_render(const char *src, const char *dest, const TemplDict *dict);
+
+#endif //_TEMPL_H_
@@ -0,0 +1,9 @@
+// ICDF lookup table case items, used by rng_lookup when RNG_LOOKUP_LUT is defined
+// Autogenerated by gen_lookup.c
+
+<%^LOOKUP_LUT%>
+// Lookup table is stored in c0.mem and c1.mem ROMs
+<%/LOOKUP_LUT%>
+<%#ENTRIES%>
+<%ADDR%> : begin c0 = <%BY%>'h<%C0%>; c1 = <%BY%>'h<%C1%>; end
+<%/ENTRIES%>
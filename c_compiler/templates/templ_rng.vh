@@ -6,6 +6,16 @@
 
 `include "urng.vh"
 
-#
+`define RNG_BY <%BY%>
+`define RNG_K <%K%>
+`define RNG_MANT_BW <%MANT_BW%>
+`define RNG_EXP_BW <%EXP_BW%>
+`define RNG_MAX_G_D <%MAX_G_D%>
+`define RNG_SEC_ADDR_SIZE <%SEC_ADDR_SIZE%>
+`define RNG_GROWING_OCT <%GROWING_OCT%>
+`define RNG_DIMINISHING_OCT <%DIMINISHING_OCT%>
+<%#LOOKUP_LUT%>
+`define RNG_LOOKUP_LUT
+<%/LOOKUP_LUT%>
 
 `endif // _rng_vh_
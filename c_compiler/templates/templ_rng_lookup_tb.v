@@ -0,0 +1,76 @@
+// rng_lookup testbench, checks every section against the coefficients computed by the compiler
+// Autogenerated by gen_lookup.c
+
+`include "utils.vh"
+`include "rng.v"
+`include "rng.vh"
+
+`timescale 1 ns/10 ps  // time-unit = 1 ns, precision = 10 ps
+
+module rng_lookup_tb;
+  reg clk, en;
+  reg [SEC_ADDR_SIZE - 1:0] section_addr;
+  reg [K - 1:0] subsection_addr;
+  wire [BY - 1:0] c0, c1;
+  integer errors;
+
+  localparam period = 20;
+  localparam delay = 5;
+
+  parameter BY = `RNG_BY;
+  parameter K = `RNG_K;
+  parameter SEC_ADDR_SIZE = `RNG_SEC_ADDR_SIZE;
+
+  rng_lookup TI(  // Test Instance
+    .clk(clk),
+    .en(en),
+    .section_addr(section_addr),
+    .subsection_addr(subsection_addr),
+    .c0(c0),
+    .c1(c1)
+  );
+
+  initial begin
+    clk = 1'b0;
+    forever #period clk = ~clk;
+  end
+
+  // Present address, then compare after the ROM read clock edge (LUT output is already settled)
+  task check(input integer section, input integer subsection, input [BY - 1:0] expected_c0, expected_c1);
+    begin
+      #delay
+      section_addr = section;
+      subsection_addr = subsection;
+      @(posedge clk);
+      #delay
+      if (c0 !== expected_c0 || c1 !== expected_c1) begin
+        $display("FAIL section %0d subsection %0d: c0 %h c1 %h, expected c0 %h c1 %h",
+          section, subsection, c0, c1, expected_c0, expected_c1);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/rng_lookup.vcd");
+    $dumpvars;
+
+    errors = 0;
+    en = 1'b1;
+    section_addr = 0;
+    subsection_addr = 0;
+    @(posedge clk);
+
+<%#SECTIONS%>
+    // Section <%SECTION%>
+<%#SUBSECTIONS%>
+    check(<%SECTION%>, <%SUBSECTION%>, <%BY%>'h<%C0%>, <%BY%>'h<%C1%>);
+<%/SUBSECTIONS%>
+
+<%/SECTIONS%>
+    if (errors == 0) begin
+      $display("PASS");
+    end
+    $finish;
+  end
+endmodule  // rng_lookup_tb
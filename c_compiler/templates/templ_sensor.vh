@@ -0,0 +1,11 @@
+// Sensor query datapath parameters
+// Autogenerated by gen_vh.c
+
+`ifndef _sensor_vh_
+`define _sensor_vh_
+
+`define SENSOR_BW <%BW%>
+`define SENSOR_MIN (<%MIN%>)
+`define SENSOR_MAX (<%MAX%>)
+
+`endif // _sensor_vh_
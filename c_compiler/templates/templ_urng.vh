@@ -4,6 +4,6 @@
 `ifndef _urng_vh_
 `define _urng_vh_
 
-#
+`define URNG_BX <%BX%>
 
 `endif //_urng_vh_
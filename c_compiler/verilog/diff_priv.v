@@ -0,0 +1,78 @@
+`include "utils.vh"
+`include "urng.vh"
+`include "rng.vh"
+`include "sensor.vh"
+`include "fifo.vh"
+`include "rng.v"
+`include "noise_fifo.v"
+`include "query.v"
+
+/*
+ * Differential privacy system top level
+ *
+ * Noise samples from rng are prefetched into noise_fifo while idle, then added to sensor readings by the query
+ * datapath.
+ *
+ * noise_fill_level -- number of noise samples held in the prefetch FIFO
+ * noise_underrun   -- a query allowed by the privacy budget found the prefetch FIFO empty and fell back to the previous
+ *                    response
+ */
+module diff_priv(
+	input clk, rst, bits_in, query_en, budget_ok,
+	input signed [SENSOR_BW - 1:0] sensor_in,
+	output signed [SENSOR_BW - 1:0] out,
+	output out_valid,
+	output [ADDR_BW:0] noise_fill_level,
+	output noise_underrun
+	);
+
+	parameter BY = `RNG_BY;
+	parameter SENSOR_BW = `SENSOR_BW;
+	parameter ADDR_BW = `NOISE_FIFO_ADDR_BW;
+
+	wire signed [BY - 1:0] rng_out;
+	wire rng_valid;
+	wire rng_transfer;  // New noise sample moves from rng to the prefetch FIFO
+	wire signed [BY - 1:0] noise;
+	wire noise_empty, noise_full;
+	wire noise_rd;
+
+	// rng is held off while the prefetch FIFO is full
+	assign rng_transfer = rng_valid & ~noise_full;
+
+	rng noise_source(
+		.clk(clk),
+		.rst(rst),
+		.bits_in(bits_in),
+		.ready(~noise_full),
+		.rng(rng_out),
+		.valid(rng_valid)
+	);
+
+	noise_fifo #(.BY(BY), .ADDR_BW(ADDR_BW)) noise_prefetch(
+		.clk(clk),
+		.rst(rst),
+		.wr_en(rng_transfer),
+		.rd_en(noise_rd),
+		.din(rng_out),
+		.dout(noise),
+		.empty(noise_empty),
+		.full(noise_full),
+		.fill_level(noise_fill_level)
+	);
+
+	query #(.BY(BY), .SENSOR_BW(SENSOR_BW)) sensor_query(
+		.clk(clk),
+		.rst(rst),
+		.query_en(query_en),
+		.budget_ok(budget_ok),
+		.noise_valid(~noise_empty),
+		.sensor_in(sensor_in),
+		.noise(noise),
+		.noise_rd(noise_rd),
+		.out(out),
+		.out_valid(out_valid),
+		.underrun(noise_underrun)
+	);
+
+endmodule  // diff_priv
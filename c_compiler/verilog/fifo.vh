@@ -0,0 +1,10 @@
+// Noise prefetch FIFO parameters
+// Autogenerated by gen_vh.c
+
+`ifndef _fifo_vh_
+`define _fifo_vh_
+
+`define NOISE_FIFO_DEPTH 8
+`define NOISE_FIFO_ADDR_BW 3
+
+`endif // _fifo_vh_
@@ -0,0 +1,31 @@
+// ICDF lookup table case items, used by rng_lookup when RNG_LOOKUP_LUT is defined
+// Autogenerated by gen_lookup.c
+
+0 : begin c0 = 16'hb17; c1 = 16'h111; end
+1 : begin c0 = 16'hd3a; c1 = 16'h13b; end
+2 : begin c0 = 16'hfb1; c1 = 16'h175; end
+3 : begin c0 = 16'h129c; c1 = 16'h1c9; end
+4 : begin c0 = 16'h162e; c1 = 16'h111; end
+5 : begin c0 = 16'h1851; c1 = 16'h13c; end
+6 : begin c0 = 16'h1ac9; c1 = 16'h175; end
+7 : begin c0 = 16'h1db3; c1 = 16'h1c9; end
+8 : begin c0 = 16'h2145; c1 = 16'h111; end
+9 : begin c0 = 16'h2368; c1 = 16'h13c; end
+10 : begin c0 = 16'h25e0; c1 = 16'h175; end
+11 : begin c0 = 16'h28cb; c1 = 16'h1c9; end
+12 : begin c0 = 16'h2c5d; c1 = 16'h24d; end
+13 : begin c0 = 16'h30f7; c1 = 16'h33e; end
+14 : begin c0 = 16'h3774; c1 = 16'h58b; end
+15 : begin c0 = 16'h428b; c1 = 16'hb17; end
+16 : begin c0 = 16'h935; c1 = 16'hf1; end
+17 : begin c0 = 16'h785; c1 = 16'hd8; end
+18 : begin c0 = 16'h5ff; c1 = 16'hc3; end
+19 : begin c0 = 16'h49a; c1 = 16'hb2; end
+20 : begin c0 = 16'h3f3; c1 = 16'h53; end
+21 : begin c0 = 16'h352; c1 = 16'h50; end
+22 : begin c0 = 16'h2b8; c1 = 16'h4d; end
+23 : begin c0 = 16'h223; c1 = 16'h4a; end
+24 : begin c0 = 16'h193; c1 = 16'h48; end
+25 : begin c0 = 16'h108; c1 = 16'h45; end
+26 : begin c0 = 16'h82; c1 = 16'h43; end
+27 : begin c0 = 16'h0; c1 = 16'h41; end
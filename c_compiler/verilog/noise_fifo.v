@@ -0,0 +1,85 @@
+`include "utils.vh"
+`include "rng.vh"
+`include "fifo.vh"
+
+/*
+ * Noise sample prefetch FIFO
+ *
+ * Buffers samples from rng so that queries are served in one cycle, hiding the data dependent rng output rate.
+ * The head of the FIFO is always presented on dout (first word fall through). The writer must hold off while the
+ * FIFO is full (rng is backpressured through its ready input), so every sample is written exactly once.
+ *
+ * Storage is read synchronously so that it maps to iCE40 block RAM, the RAM read register holds the head sample.
+ * A sample written to an empty FIFO appears on dout two cycles later.
+ *
+ * wr_en      -- one cycle strobe, din holds a new noise sample
+ * rd_en      -- head sample consumed, ignored when the FIFO is empty
+ * dout       -- sample at the head of the FIFO
+ * empty      -- no sample available, dout is invalid
+ * full       -- no space available, writes are ignored
+ * fill_level -- number of samples currently held
+ */
+module noise_fifo(
+	input clk, rst, wr_en, rd_en,
+	input signed [BY - 1:0] din,
+	output reg signed [BY - 1:0] dout,
+	output empty, full,
+	output [ADDR_BW:0] fill_level
+	);
+
+	parameter BY = `RNG_BY;
+	parameter ADDR_BW = `NOISE_FIFO_ADDR_BW;
+	localparam DEPTH = 2**ADDR_BW;
+
+	reg signed [BY - 1:0] mem [0:DEPTH - 1];
+
+	// One extra pointer bit distinguishes full from empty, rd_ptr addresses the next sample to move to dout
+	reg [ADDR_BW:0] wr_ptr, rd_ptr;
+	reg dout_valid;
+
+	wire [ADDR_BW:0] mem_level;
+	wire do_write, do_read, mem_rd;
+
+	assign mem_level = wr_ptr - rd_ptr;
+	assign fill_level = mem_level + dout_valid;
+	assign empty = ~dout_valid;
+	assign full = (fill_level == DEPTH);
+
+	assign do_write = wr_en & ~full;
+	assign do_read = rd_en & ~empty;
+	// Refill dout when it is empty or its sample is consumed this cycle
+	assign mem_rd = (mem_level != 0) & (~dout_valid | do_read);
+
+	always @ ( posedge clk ) begin
+		if (do_write) begin
+			mem[wr_ptr[ADDR_BW - 1:0]] <= din;
+		end
+	end
+
+	always @ ( posedge clk ) begin
+		if (mem_rd) begin
+			dout <= mem[rd_ptr[ADDR_BW - 1:0]];
+		end
+	end
+
+	always @ ( posedge clk ) begin
+		if (rst) begin
+			wr_ptr <= 0;
+			rd_ptr <= 0;
+			dout_valid <= 0;
+		end
+		else begin
+			if (do_write) begin
+				wr_ptr <= wr_ptr + 1;
+			end
+			if (mem_rd) begin
+				rd_ptr <= rd_ptr + 1;
+				dout_valid <= 1;
+			end
+			else if (do_read) begin
+				dout_valid <= 0;
+			end
+		end
+	end
+
+endmodule  // noise_fifo
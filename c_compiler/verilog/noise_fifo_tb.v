@@ -0,0 +1,81 @@
+`include "utils.vh"
+`include "noise_fifo.v"
+`include "rng.vh"
+`include "fifo.vh"
+
+`timescale 1 ns/10 ps  // time-unit = 1 ns, precision = 10 ps
+
+module noise_fifo_tb;
+  reg clk, rst, wr_en, rd_en;
+  reg signed [BY - 1:0] din;
+  wire signed [BY - 1:0] dout;
+  wire empty, full;
+  wire [ADDR_BW:0] fill_level;
+
+  localparam period = 20;
+  localparam delay = 5;
+
+  parameter BY = `RNG_BY;
+  parameter ADDR_BW = `NOISE_FIFO_ADDR_BW;
+  integer i;
+
+  noise_fifo TI(  // Test Instance
+    .clk(clk),
+    .rst(rst),
+    .wr_en(wr_en),
+    .rd_en(rd_en),
+    .din(din),
+    .dout(dout),
+    .empty(empty),
+    .full(full),
+    .fill_level(fill_level)
+  );
+
+  // Reset then set up clock
+  initial begin
+    clk = 1'b0;
+    rst = 1'b1;
+    repeat(3) #period clk = ~clk;
+    rst = 1'b0;
+    forever #period clk = ~clk;
+  end
+
+  initial begin
+    $dumpfile("sim/noise_fifo.vcd");
+    $dumpvars;
+    $monitor("%d,\t%b,\t%b,\t%b,\t%d,\t%d,\t%b,\t%b,\t%d",$time,clk,wr_en,rd_en,din,dout,empty,full,fill_level);
+
+    wr_en = 1'b0;  // init
+    rd_en = 1'b0;
+    din = 0;
+    @(negedge rst);  // wait for reset
+    @(posedge clk);
+
+    // Fill while idle, writes while full are ignored
+    for (i = 0; i < 2**ADDR_BW + 2; i = i + 1) begin
+      #delay
+      wr_en = 1'b1;
+      din = i - 3;
+      @(posedge clk);
+    end
+
+    // Burst of back to back reads with a slower refill
+    for (i = 0; i < 2**ADDR_BW + 2; i = i + 1) begin
+      #delay
+      rd_en = 1'b1;
+      wr_en = (i % 4 == 0);
+      din = 100 + i;
+      @(posedge clk);
+    end
+
+    // Read from empty FIFO is ignored
+    #delay
+    wr_en = 1'b0;
+    repeat(3) @(posedge clk);
+
+    #delay
+    rd_en = 1'b0;
+    repeat(2) @(posedge clk);
+    $finish;
+  end
+endmodule  // noise_fifo_tb
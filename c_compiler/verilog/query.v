@@ -0,0 +1,116 @@
+`include "utils.vh"
+`include "rng.vh"
+`include "sensor.vh"
+
+/*
+ * Noisy sensor query datapath (hardware version of Sensor.query in the Python prototype)
+ *
+ * Fully pipelined, accepts one query per clock cycle. Response appears 3 cycles after the query.
+ *  Stage 1 -- clamp sensor reading to [SENSOR_MIN, SENSOR_MAX], register noise sample
+ *  Stage 2 -- add noise sample to clamped reading
+ *  Stage 3 -- saturate to SENSOR_BW bits, latch response or fall back to previous response
+ *
+ * query_en    -- start a query this cycle
+ * budget_ok   -- privacy budget allows a new measurement to be released
+ * sensor_in   -- raw sensor reading
+ * noise       -- signed Laplace noise sample from rng
+ * noise_valid -- noise holds a fresh sample
+ * noise_rd    -- noise sample consumed this cycle
+ * out         -- query response
+ * out_valid   -- out holds the response to a query
+ * underrun    -- a query allowed by the privacy budget found no fresh noise and fell back to the previous response
+ */
+module query(
+	input clk, rst, query_en, budget_ok, noise_valid,
+	input signed [SENSOR_BW - 1:0] sensor_in,
+	input signed [BY - 1:0] noise,
+	output noise_rd,
+	output reg signed [SENSOR_BW - 1:0] out,
+	output reg out_valid,
+	output reg underrun
+	);
+
+	parameter BY = `RNG_BY;
+	parameter SENSOR_BW = `SENSOR_BW;
+	parameter SENSOR_MIN = `SENSOR_MIN;
+	parameter SENSOR_MAX = `SENSOR_MAX;
+	localparam SUM_BW = (`MAX(SENSOR_BW, BY)) + 1;
+
+	localparam signed [SENSOR_BW - 1:0] CLAMP_MIN = SENSOR_MIN;
+	localparam signed [SENSOR_BW - 1:0] CLAMP_MAX = SENSOR_MAX;
+
+	reg signed [SENSOR_BW - 1:0] clamped;
+	reg signed [SENSOR_BW - 1:0] prev_out;
+
+	// Pipeline registers
+	reg signed [SENSOR_BW - 1:0] reading_s1;
+	reg signed [BY - 1:0] noise_s1;
+	reg signed [SUM_BW - 1:0] sum_s2;
+	reg valid_s1, valid_s2;
+	reg release_s1, release_s2;
+
+	// Only consume a noise sample when a noised measurement will be released,
+	// a query without fresh noise falls back to the previous response
+	assign noise_rd = query_en & budget_ok & noise_valid;
+
+	// Combinational logic
+	always @ ( * ) begin
+		if (sensor_in < CLAMP_MIN) begin
+			clamped = CLAMP_MIN;
+		end else if (sensor_in > CLAMP_MAX) begin
+			clamped = CLAMP_MAX;
+		end else begin
+			clamped = sensor_in;
+		end
+	end
+
+	always @ ( posedge clk ) begin
+		if (rst) begin
+			reading_s1 <= 0;
+			noise_s1 <= 0;
+			sum_s2 <= 0;
+			valid_s1 <= 0;
+			valid_s2 <= 0;
+			release_s1 <= 0;
+			release_s2 <= 0;
+			prev_out <= 0;
+			out <= 0;
+			out_valid <= 0;
+			underrun <= 0;
+		end
+		else begin
+			// Stage 1: clamp
+			reading_s1 <= clamped;
+			noise_s1 <= noise;
+			valid_s1 <= query_en;
+			release_s1 <= noise_rd;
+			underrun <= query_en & budget_ok & ~noise_valid;
+
+			// Stage 2: add noise (operands are sign extended to SUM_BW bits)
+			sum_s2 <= reading_s1 + noise_s1;
+			valid_s2 <= valid_s1;
+			release_s2 <= release_s1;
+
+			// Stage 3: saturate, latch or fall back to previous response
+			out_valid <= valid_s2;
+			if (valid_s2) begin
+				if (release_s2) begin
+					if (sum_s2[SUM_BW - 1 : SENSOR_BW - 1] == {(SUM_BW - SENSOR_BW + 1){1'b0}}
+						|| sum_s2[SUM_BW - 1 : SENSOR_BW - 1] == {(SUM_BW - SENSOR_BW + 1){1'b1}}) begin
+						// Sum fits within SENSOR_BW bits
+						out <= sum_s2[SENSOR_BW - 1:0];
+						prev_out <= sum_s2[SENSOR_BW - 1:0];
+					end else begin
+						// Overflow, saturate towards the sign of the sum
+						out <= {sum_s2[SUM_BW - 1], {(SENSOR_BW - 1){~sum_s2[SUM_BW - 1]}}};
+						prev_out <= {sum_s2[SUM_BW - 1], {(SENSOR_BW - 1){~sum_s2[SUM_BW - 1]}}};
+					end
+				end else begin
+					// Insufficient privacy budget or noise, no new information revealed
+					out <= prev_out;
+				end
+			end
+		end
+	end
+
+endmodule  // query
@@ -0,0 +1,103 @@
+`include "utils.vh"
+`include "query.v"
+`include "rng.vh"
+`include "sensor.vh"
+
+`timescale 1 ns/10 ps  // time-unit = 1 ns, precision = 10 ps
+
+module query_tb;
+  reg clk, rst, query_en, budget_ok, noise_valid;
+  reg signed [SENSOR_BW - 1:0] sensor_in;
+  reg signed [BY - 1:0] noise;
+  wire noise_rd;
+  wire signed [SENSOR_BW - 1:0] out;
+  wire out_valid;
+  wire underrun;
+
+  localparam period = 20;
+  localparam delay = 5;
+
+  parameter BY = `RNG_BY;
+  parameter SENSOR_BW = `SENSOR_BW;
+
+  query TI(  // Test Instance
+    .clk(clk),
+    .rst(rst),
+    .query_en(query_en),
+    .budget_ok(budget_ok),
+    .noise_valid(noise_valid),
+    .sensor_in(sensor_in),
+    .noise(noise),
+    .noise_rd(noise_rd),
+    .out(out),
+    .out_valid(out_valid),
+    .underrun(underrun)
+  );
+
+  // Reset then set up clock
+  initial begin
+    clk = 1'b0;
+    rst = 1'b1;
+    repeat(3) #period clk = ~clk;
+    rst = 1'b0;
+    forever #period clk = ~clk;
+  end
+
+  initial begin
+    $dumpfile("sim/query.vcd");
+    $dumpvars;
+    $monitor("%d,\t%b,\t%b,\t%b,\t%d,\t%d,\t%b,\t%d,\t%b,\t%b",$time,clk,query_en,budget_ok,sensor_in,noise,noise_rd,out,out_valid,underrun);
+
+    query_en = 1'b0;  // init
+    budget_ok = 1'b1;
+    noise_valid = 1'b1;
+    sensor_in = 0;
+    noise = 0;
+    @(negedge rst);  // wait for reset
+    @(posedge clk);
+
+    // Back to back queries, one per clock
+    #delay
+    query_en = 1'b1;
+    sensor_in = 100;
+    noise = -3;
+    @(posedge clk);
+
+    // Reading above SENSOR_MAX is clamped
+    #delay
+    sensor_in = `SENSOR_MAX + 1000;
+    noise = 5;
+    @(posedge clk);
+
+    // Reading below SENSOR_MIN is clamped
+    #delay
+    sensor_in = `SENSOR_MIN - 1000;
+    noise = -5;
+    @(posedge clk);
+
+    // Large noise sample saturates response
+    #delay
+    sensor_in = `SENSOR_MAX;
+    noise = {1'b0, {(BY - 1){1'b1}}};
+    @(posedge clk);
+
+    // Insufficient budget, previous response returned
+    #delay
+    budget_ok = 1'b0;
+    sensor_in = 7;
+    noise = 1;
+    @(posedge clk);
+
+    // No fresh noise, previous response returned and underrun flagged
+    #delay
+    budget_ok = 1'b1;
+    noise_valid = 1'b0;
+    @(posedge clk);
+
+    #delay
+    query_en = 1'b0;
+    noise_valid = 1'b1;
+    repeat(4) @(posedge clk);
+    $finish;
+  end
+endmodule  // query_tb
@@ -4,8 +4,18 @@
 `include "utils.vh"
 `include "clz.v"
 
+/*
+ * Convert uniform random bit vectors to floating point representation
+ *
+ * A uniform random number is latched, then processed once the clz result is available. Random numbers with a zero
+ * exponent part are re-drawn, accumulating leading zeros until the exponent reaches max_exp. The symm, part and
+ * mantissa bits come from the final draw.
+ *
+ * float_rd    -- floating holds a sample which has been consumed, draw the next one
+ * rst_urng    -- request a new uniform random number from the URNG
+ */
 module rng_uniform_to_float(
-	input clk, rst, urng_valid,
+	input clk, rst, urng_valid, float_rd,
 	input [BX - 1:0] uniform,
 	output reg [BX - 1:0] floating,
 	output reg float_valid,
@@ -47,37 +57,43 @@ module rng_uniform_to_float(
 			rst_urng <= 0;
 			//max_exp <= 0;
 			uniform_pipe <= 0;
+			urng_valid_pipe <= 0;
 		end
 
-		else if(!float_valid) begin
-		// Keep requesting new random numbers until exponent part is nonzero
-			if (urng_valid) begin
-				// A valid uniform random bit vector has been received
-				if (uniform[BX - 3 : MANT_BW] == 0) begin
-		    	// Consume another random number if exponent part is zero
-		      rst_urng <= 1;
-		    end
-				// else can stop consuming random numbers
+		else if(float_valid) begin
+			if (float_rd) begin
+				// Sample consumed, clear exponent accumulator and draw a fresh uniform random number
+				float_valid <= 0;
+				floating <= 0;
+				rst_urng <= 1;
 			end
-			else if (rst_urng) begin
-				rst_urng <= 0;  // Clear reset signal
+		end
+
+		else if (rst_urng) begin
+			rst_urng <= 0;  // URNG is held in reset for one cycle, ignore its stale output
+		end
+
+		else if (urng_valid_pipe) begin
+		// Process uniform random number latched in the previous cycle
+			urng_valid_pipe <= 0;
+			if (floating[BX - 3 : MANT_BW] + leading_zeros >= max_exp) begin
+				floating[BX - 3 : MANT_BW] <= max_exp;  // Exponent
+				float_valid <= 1;
+			end else begin
+				floating[BX - 3 : MANT_BW] <= floating[BX - 3 : MANT_BW] + leading_zeros;
+				float_valid <= clz_valid;
+				// Keep requesting new random numbers until exponent part is nonzero
+				rst_urng <= ~clz_valid;
 			end
+			floating[BX - 1] <= uniform_pipe[BX - 1];  // symm
+			floating[BX - 2] <= uniform_pipe[BX - 2];  // part
+			floating[MANT_BW-1:0] <= uniform_pipe[MANT_BW-1:0];  // mantissa
+		end
 
-		// Process an incoming uniform random number
+		else if (urng_valid) begin
+			// A valid uniform random bit vector has been received
 			uniform_pipe <= uniform;  // delay by one clock cycle to synchronise with clz module
-			urng_valid_pipe <= urng_valid;
-			if(urng_valid_pipe) begin
-				if (floating[BX - 3 : MANT_BW] + leading_zeros > max_exp) begin
-					floating[BX - 3 : MANT_BW] <= max_exp;  // Exponent
-					float_valid <= urng_valid_pipe;
-				end else begin
-					floating[BX - 3 : MANT_BW] <= floating[BX - 3 : MANT_BW] + leading_zeros;
-					float_valid <= clz_valid & urng_valid_pipe;
-				end
-				floating[BX - 1] <= uniform_pipe[BX - 1];  // symm
-				floating[BX - 2] <= uniform_pipe[BX - 2];  // part
-				floating[MANT_BW-1:0] <= uniform_pipe[MANT_BW-1:0];  // mantissa
-			end
+			urng_valid_pipe <= 1;
 		end
 	end
 
@@ -105,6 +121,15 @@ module rng_lookup(
 	parameter D_OCT = `RNG_DIMINISHING_OCT;
 	parameter SEC_ADDR_SIZE = `RNG_SEC_ADDR_SIZE;
 
+`ifdef RNG_LOOKUP_LUT
+	// Small tables are emitted by the compiler as case items, saving a clocked ROM read and BRAM
+	always @ ( * ) begin
+		case(section_addr * 2**K + subsection_addr)
+			`include "lookup.vh"
+			default : begin c0 = 0; c1 = 0; end
+		endcase
+	end
+`else
 	reg [BY-1:0] lookup_mem_c0 [0:(G_OCT+D_OCT)*2**K - 1];
 	reg [BY-1:0] lookup_mem_c1 [0:(G_OCT+D_OCT)*2**K - 1];
 
@@ -119,11 +144,22 @@ module rng_lookup(
 			c1 <= lookup_mem_c1[section_addr * 2**K + subsection_addr];
 		end
 	end
+`endif
 
 endmodule  // rng_lookup
 
-module rng(
-	input clk, rst, bits_in,
+/*
+ * Laplace distributed random number generator datapath, driven by an external URNG
+ *
+ * urng_valid   -- uniform holds a new uniform random number
+ * urng_refresh -- uniform has been used, the URNG should be reset and draw a new number
+ * valid        -- rng holds a sample which has not yet been consumed
+ * ready        -- consumer takes the sample this cycle, a sample is transferred when valid and ready are both high
+ */
+module rng_core(
+	input clk, rst, urng_valid, ready,
+	input [BX - 1:0] uniform,
+	output urng_refresh,
 	output reg signed [BY - 1:0] rng,
 	output reg valid
 	);
@@ -136,16 +172,10 @@ module rng(
 	parameter SEC_ADDR_SIZE = `RNG_SEC_ADDR_SIZE;
 	integer OFFSET = `RNG_GROWING_OCT;
 
-	reg valid_pipe;
-
-	integer sign = 1;
-
-	wire urng_rst, urng_refresh;
-	wire [BX - 1:0] urng_out;
-	wire [BX - 1:0] urng_valid;
-
 	wire signed [BX-1:0] float_out;
 	wire float_valid;
+	wire float_rd;
+	wire lookup_valid;  // lookup_c0 and lookup_c1 correspond to float_out
 
 	wire float_symm;
 	wire float_part;
@@ -154,28 +184,21 @@ module rng(
 	wire [SEC_ADDR_SIZE-1:0] lookup_section_addr;
 	wire [K-1:0] lookup_subsection_addr;
 	wire signed [BY - 1:0] lookup_c0, lookup_c1;
-
-	assign urng_rst = rst | urng_refresh;
+	wire [BY - 1:0] magnitude;
 
 	assign float_symm = float_out[BX-1];
 	assign float_part = float_out[MANT_BW + EXP_BW];
 	assign float_exponent = float_out[MANT_BW+EXP_BW - 1:MANT_BW];
 	assign lookup_section_addr = ( float_part == 0 )? {1'b0,float_exponent} : ({1'b0,float_exponent} + OFFSET);
 	assign lookup_subsection_addr = float_out[MANT_BW - 1:MANT_BW - K];
-
-	uniform_rng #(.N(BX)) urng(
-	  .comparator_output(bits_in),
-	  .clk(clk),
-	  .rst(urng_rst),
-	  .out(urng_out),
-	  .valid(urng_valid)
-	);
+	assign magnitude = lookup_c0 + lookup_c1 * float_out[MANT_BW-K-1:0];  // TODO: use hardware multiplier (SB_MAC16) if possible
 
 	rng_uniform_to_float #(.BX(BX), .MANT_BW(MANT_BW)) u_to_f(
 		.clk(clk),
 		.rst(rst),
-		.urng_valid(urng_valid[BX-1]),
-		.uniform(urng_out),
+		.urng_valid(urng_valid),
+		.float_rd(float_rd),
+		.uniform(uniform),
 		.floating(float_out),
 		.float_valid(float_valid),
 		.rst_urng(urng_refresh)
@@ -190,19 +213,79 @@ module rng(
 		.c1(lookup_c1)
 	);
 
+`ifdef RNG_LOOKUP_LUT
+	assign lookup_valid = float_valid;  // Combinational lookup, no ROM read stage
+`else
+	reg lookup_valid_pipe;
+	assign lookup_valid = lookup_valid_pipe;
+
+	always @ ( posedge clk ) begin
+		if (rst) begin
+			lookup_valid_pipe <= 0;
+		end
+		else begin
+			lookup_valid_pipe <= float_valid & ~float_rd;  // ROM read stage
+		end
+	end
+`endif
+
+	// Release floating point sample once it is captured in the output register
+	assign float_rd = lookup_valid & (~valid | ready);
+
 	always @ ( posedge clk ) begin
 		if (rst) begin
 			rng <= 0;
+			valid <= 0;
 		end
 		else begin
-			if(float_symm) begin
-				sign = -1;
-			end else begin
+			if (float_rd) begin
+				rng <= (float_symm) ? -magnitude : magnitude;
+				valid <= 1;
+			end
+			else if (ready) begin
+				valid <= 0;
 			end
-
-			rng <= (lookup_c0 + lookup_c1 * float_out[MANT_BW-K-1:0]) * sign;  // TODO: use hardware multiplier (SB_MAC16) if possible
-			valid_pipe <= float_valid;  // TODO: fix pipeline timings
-			valid <= valid_pipe;
 		end
 	end
+endmodule  // rng_core
+
+/*
+ * Laplace distributed random number generator
+ *
+ * valid -- rng holds a sample which has not yet been consumed
+ * ready -- consumer takes the sample this cycle, a sample is transferred when valid and ready are both high
+ */
+module rng(
+	input clk, rst, bits_in, ready,
+	output signed [BY - 1:0] rng,
+	output valid
+	);
+
+	parameter BX = `URNG_BX;
+	parameter BY = `RNG_BY;
+
+	wire urng_rst, urng_refresh;
+	wire [BX - 1:0] urng_out;
+	wire [BX - 1:0] urng_valid;
+
+	assign urng_rst = rst | urng_refresh;
+
+	uniform_rng #(.N(BX)) urng(
+	  .comparator_output(bits_in),
+	  .clk(clk),
+	  .rst(urng_rst),
+	  .out(urng_out),
+	  .valid(urng_valid)
+	);
+
+	rng_core core(
+		.clk(clk),
+		.rst(rst),
+		.urng_valid(urng_valid[BX-1]),
+		.ready(ready),
+		.uniform(urng_out),
+		.urng_refresh(urng_refresh),
+		.rng(rng),
+		.valid(valid)
+	);
 endmodule  // rng
@@ -6,13 +6,14 @@
 
 `include "urng.vh"
 
-`define RNG_BY 16
-`define RNG_K 2
-`define RNG_MANT_BW 3
-`define RNG_EXP_BW 3
-`define RNG_MAX_G_D 4
-`define RNG_SEC_ADDR_SIZE 4
-`define RNG_GROWING_OCT 4
+`define RNG_BY 16
+`define RNG_K 2
+`define RNG_MANT_BW 3
+`define RNG_EXP_BW 3
+`define RNG_MAX_G_D 4
+`define RNG_SEC_ADDR_SIZE 4
+`define RNG_GROWING_OCT 4
 `define RNG_DIMINISHING_OCT 3
+`define RNG_LOOKUP_LUT
 
 `endif // _rng_vh_
@@ -0,0 +1,93 @@
+`include "utils.vh"
+`include "rng.v"
+`include "rng.vh"
+
+`timescale 1 ns/10 ps  // time-unit = 1 ns, precision = 10 ps
+
+/*
+ * Drives rng_core with recorded uniform random numbers and writes each transferred sample to sim/rng_core.out
+ *
+ * sim/uniform.mem holds STREAM_LEN BX bit hex numbers, one per line (written by python-diff-priv/test_fastrng.py).
+ * The consumer applies random backpressure.
+ */
+module rng_core_tb;
+  reg clk, rst, urng_valid, ready;
+  reg [BX - 1:0] uniform;
+  wire urng_refresh;
+  wire signed [BY - 1:0] out;
+  wire valid;
+
+  localparam period = 20;
+  localparam delay = 5;
+
+  parameter BX = `URNG_BX;
+  parameter BY = `RNG_BY;
+  parameter STREAM_LEN = 4096;
+
+  reg [BX - 1:0] stream [0:STREAM_LEN - 1];
+  integer stream_pos, fill, out_file;
+  integer seed = 1;
+
+  rng_core TI(  // Test Instance
+    .clk(clk),
+    .rst(rst),
+    .urng_valid(urng_valid),
+    .ready(ready),
+    .uniform(uniform),
+    .urng_refresh(urng_refresh),
+    .rng(out),
+    .valid(valid)
+  );
+
+  // Reset then set up clock
+  initial begin
+    clk = 1'b0;
+    rst = 1'b1;
+    repeat(3) #period clk = ~clk;
+    rst = 1'b0;
+    forever #period clk = ~clk;
+  end
+
+  // Stand-in URNG, presents the next recorded number BX cycles after each reset
+  always @ ( posedge clk ) begin
+    if (rst | urng_refresh) begin
+      urng_valid <= 1'b0;
+      fill <= BX;
+    end else if (fill > 0) begin
+      fill <= fill - 1;
+    end else if (~urng_valid && stream_pos < STREAM_LEN) begin
+      uniform <= stream[stream_pos];
+      stream_pos <= stream_pos + 1;
+      urng_valid <= 1'b1;
+    end
+  end
+
+  // Consumer, takes samples on three cycles out of four on average
+  always @ ( posedge clk ) begin
+    if (valid & ready) begin
+      $fwrite(out_file, "%0d\n", out);
+    end
+  end
+
+  always @ ( negedge clk ) begin
+    ready = ($random(seed) & 3) != 0;
+  end
+
+  initial begin
+    $dumpfile("sim/rng_core.vcd");
+    $dumpvars;
+
+    $readmemh("sim/uniform.mem", stream);
+    out_file = $fopen("sim/rng_core.out", "w");
+    stream_pos = 0;
+    urng_valid = 1'b0;
+    uniform = {BX{1'b0}};
+    @(negedge rst);  // wait for reset
+
+    // Allow the final sample to drain
+    wait (stream_pos == STREAM_LEN);
+    repeat(4 * BX + 20) @(posedge clk);
+    $fclose(out_file);
+    $finish;
+  end
+endmodule  // rng_core_tb
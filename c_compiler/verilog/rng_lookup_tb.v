@@ -0,0 +1,111 @@
+// rng_lookup testbench, checks every section against the coefficients computed by the compiler
+// Autogenerated by gen_lookup.c
+
+`include "utils.vh"
+`include "rng.v"
+`include "rng.vh"
+
+`timescale 1 ns/10 ps  // time-unit = 1 ns, precision = 10 ps
+
+module rng_lookup_tb;
+  reg clk, en;
+  reg [SEC_ADDR_SIZE - 1:0] section_addr;
+  reg [K - 1:0] subsection_addr;
+  wire [BY - 1:0] c0, c1;
+  integer errors;
+
+  localparam period = 20;
+  localparam delay = 5;
+
+  parameter BY = `RNG_BY;
+  parameter K = `RNG_K;
+  parameter SEC_ADDR_SIZE = `RNG_SEC_ADDR_SIZE;
+
+  rng_lookup TI(  // Test Instance
+    .clk(clk),
+    .en(en),
+    .section_addr(section_addr),
+    .subsection_addr(subsection_addr),
+    .c0(c0),
+    .c1(c1)
+  );
+
+  initial begin
+    clk = 1'b0;
+    forever #period clk = ~clk;
+  end
+
+  // Present address, then compare after the ROM read clock edge (LUT output is already settled)
+  task check(input integer section, input integer subsection, input [BY - 1:0] expected_c0, expected_c1);
+    begin
+      #delay
+      section_addr = section;
+      subsection_addr = subsection;
+      @(posedge clk);
+      #delay
+      if (c0 !== expected_c0 || c1 !== expected_c1) begin
+        $display("FAIL section %0d subsection %0d: c0 %h c1 %h, expected c0 %h c1 %h",
+          section, subsection, c0, c1, expected_c0, expected_c1);
+        errors = errors + 1;
+      end
+    end
+  endtask
+
+  initial begin
+    $dumpfile("sim/rng_lookup.vcd");
+    $dumpvars;
+
+    errors = 0;
+    en = 1'b1;
+    section_addr = 0;
+    subsection_addr = 0;
+    @(posedge clk);
+
+    // Section 0
+    check(0, 0, 16'hb17, 16'h111);
+    check(0, 1, 16'hd3a, 16'h13b);
+    check(0, 2, 16'hfb1, 16'h175);
+    check(0, 3, 16'h129c, 16'h1c9);
+
+    // Section 1
+    check(1, 0, 16'h162e, 16'h111);
+    check(1, 1, 16'h1851, 16'h13c);
+    check(1, 2, 16'h1ac9, 16'h175);
+    check(1, 3, 16'h1db3, 16'h1c9);
+
+    // Section 2
+    check(2, 0, 16'h2145, 16'h111);
+    check(2, 1, 16'h2368, 16'h13c);
+    check(2, 2, 16'h25e0, 16'h175);
+    check(2, 3, 16'h28cb, 16'h1c9);
+
+    // Section 3
+    check(3, 0, 16'h2c5d, 16'h24d);
+    check(3, 1, 16'h30f7, 16'h33e);
+    check(3, 2, 16'h3774, 16'h58b);
+    check(3, 3, 16'h428b, 16'hb17);
+
+    // Section 4
+    check(4, 0, 16'h935, 16'hf1);
+    check(4, 1, 16'h785, 16'hd8);
+    check(4, 2, 16'h5ff, 16'hc3);
+    check(4, 3, 16'h49a, 16'hb2);
+
+    // Section 5
+    check(5, 0, 16'h3f3, 16'h53);
+    check(5, 1, 16'h352, 16'h50);
+    check(5, 2, 16'h2b8, 16'h4d);
+    check(5, 3, 16'h223, 16'h4a);
+
+    // Section 6
+    check(6, 0, 16'h193, 16'h48);
+    check(6, 1, 16'h108, 16'h45);
+    check(6, 2, 16'h82, 16'h43);
+    check(6, 3, 16'h0, 16'h41);
+
+    if (errors == 0) begin
+      $display("PASS");
+    end
+    $finish;
+  end
+endmodule  // rng_lookup_tb
@@ -20,6 +20,7 @@ module rng_tb;
     .clk(clk),
     .rst(rst),
     .bits_in(bits_in),
+    .ready(1'b1),
     .rng(out),
     .valid(valid)
   );
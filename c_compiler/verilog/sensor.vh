@@ -0,0 +1,11 @@
+// Sensor query datapath parameters
+// Autogenerated by gen_vh.c
+
+`ifndef _sensor_vh_
+`define _sensor_vh_
+
+`define SENSOR_BW 16
+`define SENSOR_MIN (-2048)
+`define SENSOR_MAX (2047)
+
+`endif // _sensor_vh_
@@ -4,7 +4,6 @@
 `ifndef _urng_vh_
 `define _urng_vh_
 
-`define URNG_BX 8
-
+`define URNG_BX 8
 
 `endif //_urng_vh_
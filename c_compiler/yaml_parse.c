@@ -3,12 +3,15 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <stdbool.h>
 #include "yaml_parse.h"
 
 typedef enum heading_1
 {
     URNG_HEADING_1,
     RNG_HEADING_1,
+    SENSOR_HEADING_1,
+    FIFO_HEADING_1,
     NUM_HEADINGS
 }Heading_1;
 
@@ -26,14 +29,48 @@ typedef enum rng_fields
     RNG_DIMINISHING_OCT
 }Rng_fields;
 
+typedef enum sensor_fields
+{
+    SENSOR_BW,
+    SENSOR_MIN,
+    SENSOR_MAX
+}Sensor_fields;
+
+typedef enum fifo_fields
+{
+    FIFO_DEPTH,
+    FIFO_BURST_LEN,
+    FIFO_QUERY_PERIOD,
+    FIFO_SAMPLE_PERIOD
+}Fifo_fields;
+
+typedef struct fifo_field_range
+{
+    const char *name;
+    long min;
+    long max;
+}Fifo_field_range;
+
+// Allowed NOISE_FIFO values, indexed by Fifo_fields. DEPTH and SAMPLE_PERIOD are derived when 0.
+// 128 samples fit in one iCE40 block RAM (SB_RAM40_4K, 256x16) per 16 bits of RNG BY.
+static const Fifo_field_range fifo_field_ranges[] = {
+    [FIFO_DEPTH] = {"DEPTH", 0, 128},
+    [FIFO_BURST_LEN] = {"BURST_LEN", 1, UINT8_MAX},
+    [FIFO_QUERY_PERIOD] = {"QUERY_PERIOD", 1, UINT8_MAX},
+    [FIFO_SAMPLE_PERIOD] = {"SAMPLE_PERIOD", 0, UINT8_MAX}
+};
+
 typedef struct parser_state
 {
     // Addresses of data structs to populate from YAML file
     UrngData *urng_data_addr;
     RngData *rng_data_addr;
+    SensorData *sensor_data_addr;
+    FifoData *fifo_data_addr;
     Heading_1 current_heading_1;  // Name of struct currently being populated
     uint8_t current_field;        // Current field to fill in
     void *current_field_addr;  // Address of current field
+    bool heading_found[NUM_HEADINGS];  // Headings present in the YAML file
 }Parser_state;
 
 Heading_1 get_current_heading(const yaml_event_t *const event)
@@ -50,6 +87,14 @@ Heading_1 get_current_heading(const yaml_event_t *const event)
     {
         return RNG_HEADING_1;
     }
+    else if(strncmp((char *)event->data.scalar.value, "SENSOR", 6)==0)
+    {
+        return SENSOR_HEADING_1;
+    }
+    else if(strncmp((char *)event->data.scalar.value, "NOISE_FIFO", 10)==0)
+    {
+        return FIFO_HEADING_1;
+    }
     else{
         printf("Unrecognised heading \"%s\"\n",event->data.scalar.value);
         exit(EXIT_FAILURE);
@@ -113,6 +158,69 @@ Rng_fields get_current_field_rng(const yaml_event_t *const event, Parser_state *
     }
 }
 
+Sensor_fields get_current_field_sensor(const yaml_event_t *const event, Parser_state *const state)
+{
+    /* Return Sensor field number based on name in yaml event
+     *
+     * event -- pointer to yaml parser event
+     * state -- pointer to state of parser loop
+     */
+    if(strncmp((char *)event->data.scalar.value, "BW", 2)==0)
+    {
+        state->current_field_addr = (void*)&state->sensor_data_addr->BW;
+        return SENSOR_BW;
+    }
+    else if(strncmp((char *)event->data.scalar.value, "MIN", 3)==0)
+    {
+        state->current_field_addr = (void*)&state->sensor_data_addr->MIN;
+        return SENSOR_MIN;
+    }
+    else if(strncmp((char *)event->data.scalar.value, "MAX", 3)==0)
+    {
+        state->current_field_addr = (void*)&state->sensor_data_addr->MAX;
+        return SENSOR_MAX;
+    }
+    else
+    {
+        printf("Unrecognised heading \"%s\"\n",event->data.scalar.value);
+        exit(EXIT_FAILURE);
+    }
+}
+
+Fifo_fields get_current_field_fifo(const yaml_event_t *const event, Parser_state *const state)
+{
+    /* Return Fifo field number based on name in yaml event
+     *
+     * event -- pointer to yaml parser event
+     * state -- pointer to state of parser loop
+     */
+    if(strncmp((char *)event->data.scalar.value, "DEPTH", 5)==0)
+    {
+        state->current_field_addr = (void*)&state->fifo_data_addr->DEPTH;
+        return FIFO_DEPTH;
+    }
+    else if(strncmp((char *)event->data.scalar.value, "BURST_LEN", 9)==0)
+    {
+        state->current_field_addr = (void*)&state->fifo_data_addr->BURST_LEN;
+        return FIFO_BURST_LEN;
+    }
+    else if(strncmp((char *)event->data.scalar.value, "QUERY_PERIOD", 12)==0)
+    {
+        state->current_field_addr = (void*)&state->fifo_data_addr->QUERY_PERIOD;
+        return FIFO_QUERY_PERIOD;
+    }
+    else if(strncmp((char *)event->data.scalar.value, "SAMPLE_PERIOD", 13)==0)
+    {
+        state->current_field_addr = (void*)&state->fifo_data_addr->SAMPLE_PERIOD;
+        return FIFO_SAMPLE_PERIOD;
+    }
+    else
+    {
+        printf("Unrecognised heading \"%s\"\n",event->data.scalar.value);
+        exit(EXIT_FAILURE);
+    }
+}
+
 uint8_t get_current_field(const yaml_event_t *const event, Parser_state *const state)
 {
     /* Return field number from yaml event based on current Heading_1 and parser state
@@ -126,6 +234,10 @@ uint8_t get_current_field(const yaml_event_t *const event, Parser_state *const s
             return get_current_field_urng(event, state);
         case RNG_HEADING_1:
             return get_current_field_rng(event, state);
+        case SENSOR_HEADING_1:
+            return get_current_field_sensor(event, state);
+        case FIFO_HEADING_1:
+            return get_current_field_fifo(event, state);
         default:
             printf("Forgot to add case for heading no. \"%d\"\n",state->current_heading_1);
             exit(EXIT_FAILURE);
@@ -141,10 +253,38 @@ void handle_value(const yaml_event_t *const event, Parser_state *state)
      */
 
     // Add switch case here to accommodate fields that cannot be handled in the following default case:
+    switch(state->current_heading_1)
+    {
+        case SENSOR_HEADING_1:
+            if(state->current_field == SENSOR_MIN || state->current_field == SENSOR_MAX)
+            {
+                // Sensor limits are signed and may be wider than 8 bits
+                *(int64_t*)state->current_field_addr = (int64_t)atoll((char *)event->data.scalar.value);
+                return;
+            }
+            break;
+        case FIFO_HEADING_1:
+        {
+            // Range check before narrowing, so that out of range values are not wrapped into range
+            const Fifo_field_range *range = &fifo_field_ranges[state->current_field];
+            char *end;
+            long value = strtol((char *)event->data.scalar.value, &end, 10);
+            if(end == (char *)event->data.scalar.value || *end != '\0' || value < range->min || value > range->max)
+            {
+                printf("NOISE_FIFO %s should be an integer between %ld and %ld\n", range->name, range->min, range->max);
+                exit(EXIT_FAILURE);
+            }
+            *(uint8_t*)state->current_field_addr = (uint8_t)value;
+            return;
+        }
+        default:
+            break;
+    }
     *(uint8_t*)state->current_field_addr = (uint8_t)atoi((char *)event->data.scalar.value);
 }
 
-int yaml_parse_parse(const char *filename, UrngData *const urng_data, RngData *const rng_data)
+int yaml_parse_parse(const char *filename, UrngData *const urng_data, RngData *const rng_data,
+                     SensorData *const sensor_data, FifoData *const fifo_data)
 {
     FILE *yaml_file = fopen(filename, "r");
     printf("Parsing YAML file: \"%s\"\n", filename);
@@ -171,15 +311,20 @@ int yaml_parse_parse(const char *filename, UrngData *const urng_data, RngData *c
     Parser_state state = {
             .urng_data_addr = urng_data,
             .rng_data_addr = rng_data,
+            .sensor_data_addr = sensor_data,
+            .fifo_data_addr = fifo_data,
             .current_heading_1 = NUM_HEADINGS,
             .current_field = 0,
-            .current_field_addr = NULL
+            .current_field_addr = NULL,
+            .heading_found = {false}
     };
 
     // Add new structs here, add their addresses to the data_structs array below
     size_t data_structs[NUM_HEADINGS];
     data_structs[URNG_HEADING_1] = (size_t)&urng_data;
     data_structs[RNG_HEADING_1] = (size_t)&rng_data;
+    data_structs[SENSOR_HEADING_1] = (size_t)&sensor_data;
+    data_structs[FIFO_HEADING_1] = (size_t)&fifo_data;
 
     do
     {
@@ -198,6 +343,7 @@ int yaml_parse_parse(const char *filename, UrngData *const urng_data, RngData *c
                 {
                     case 1:
                         state.current_heading_1 = get_current_heading(&event);
+                        state.heading_found[state.current_heading_1] = true;
                         break;
                     case 2:
                         if(!state.current_field_addr)
@@ -231,26 +377,117 @@ int yaml_parse_parse(const char *filename, UrngData *const urng_data, RngData *c
     yaml_parser_delete(&parser);
     fclose(yaml_file);
 
+    // Sections without defaults
+    if (!state.heading_found[SENSOR_HEADING_1])
+    {
+        printf("Missing SENSOR section in \"%s\"\n", filename);
+        exit(EXIT_FAILURE);
+    }
+    if (!state.heading_found[FIFO_HEADING_1])
+    {
+        printf("Missing NOISE_FIFO section in \"%s\"\n", filename);
+        exit(EXIT_FAILURE);
+    }
+
     // Calculate required BX value
-    state.rng_data_addr->MAX_G_D = state.rng_data_addr->GROWING_OCT;
+    if (yaml_parse_derive_rng(state.urng_data_addr, state.rng_data_addr))
+    {
+        exit(EXIT_FAILURE);
+    }
 
-    if (state.rng_data_addr->DIMINISHING_OCT > state.rng_data_addr->MAX_G_D)
+    // Sensor limits are written into Verilog as 32 bit integer literals
+    if (state.sensor_data_addr->BW < 2 || state.sensor_data_addr->BW > 32)
     {
-        state.rng_data_addr->MAX_G_D = state.rng_data_addr->DIMINISHING_OCT;
+        printf("SENSOR BW should be between 2 and 32 bits\n");
+        exit(EXIT_FAILURE);
     }
 
-    state.rng_data_addr->EXP_BW = 1 + ceil(log2(state.rng_data_addr->MAX_G_D));
-    state.rng_data_addr->SEC_ADDR_SIZE = 1 + ceil(log2(state.rng_data_addr->GROWING_OCT + state.rng_data_addr->DIMINISHING_OCT));
-    state.urng_data_addr->BX = 2 + state.rng_data_addr->MANT_BW + state.rng_data_addr->EXP_BW;
+    if (state.sensor_data_addr->MIN > state.sensor_data_addr->MAX)
+    {
+        // Ensure max and min are the right way round
+        int64_t tmp = state.sensor_data_addr->MIN;
+        state.sensor_data_addr->MIN = state.sensor_data_addr->MAX;
+        state.sensor_data_addr->MAX = tmp;
+    }
+
+    int64_t sensor_limit = 1LL << (state.sensor_data_addr->BW - 1);
+    if (state.sensor_data_addr->MIN < -sensor_limit || state.sensor_data_addr->MAX > sensor_limit - 1)
+    {
+        printf("SENSOR MIN and MAX must fit in a %d bit signed integer\n", state.sensor_data_addr->BW);
+        exit(EXIT_FAILURE);
+    }
+
+    // Missing fields are left at zero
+    if (state.fifo_data_addr->BURST_LEN == 0 || state.fifo_data_addr->QUERY_PERIOD == 0)
+    {
+        printf("NOISE_FIFO BURST_LEN and QUERY_PERIOD should be nonzero\n");
+        exit(EXIT_FAILURE);
+    }
+    return 0;
+}
+
+int yaml_parse_derive_fifo(const UrngData *const urng_data, const RngData *const rng_data, FifoData *const fifo,
+                           int use_lut)
+{
+    if (fifo->SAMPLE_PERIOD == 0)
+    {
+        // Each draw fills the URNG (BX cycles), then latches it for the clz (1), processes it (1) and resets the
+        // URNG (1). A draw is repeated if its EXP_BW exponent bits are all zero, probability 2^-EXP_BW.
+        double draw_cycles = urng_data->BX + 3;
+        double draws = 1.0 / (1.0 - ldexp(1.0, -rng_data->EXP_BW));
+        // ROM lookup adds a read stage, then the sample is registered on the rng output
+        unsigned int lookup_cycles = use_lut ? 0 : 1;
+        double period = ceil(draw_cycles * draws) + lookup_cycles + 1;
+        fifo->SAMPLE_PERIOD = (uint8_t)((period > 255) ? 255 : period);
+    }
+
+    // Samples consumed during a burst, less those produced by the RNG between the first and last query
+    unsigned int produced = ((unsigned int)(fifo->BURST_LEN - 1) * fifo->QUERY_PERIOD) / fifo->SAMPLE_PERIOD;
+    unsigned int required = (produced < fifo->BURST_LEN) ? fifo->BURST_LEN - produced : 1;
+
+    bool auto_depth = (fifo->DEPTH == 0);
+    if (auto_depth)
+    {
+        fifo->DEPTH = (uint8_t)((required > 128) ? 128 : required);
+    }
+
+    if (fifo->DEPTH < required)
+    {
+        printf("Warning: NOISE_FIFO DEPTH %d may underrun, burst profile requires %u entries\n", fifo->DEPTH, required);
+    }
+
+    // Round depth up to a power of two so that read/write pointers wrap naturally
+    uint8_t depth = fifo->DEPTH;
+    fifo->ADDR_BW = (depth <= 2) ? 1 : (uint8_t)ceil(log2(depth));
+    fifo->DEPTH = (uint8_t)(1U << fifo->ADDR_BW);
+    if (!auto_depth && fifo->DEPTH != depth)
+    {
+        printf("Warning: NOISE_FIFO DEPTH %d rounded up to %d entries\n", depth, fifo->DEPTH);
+    }
+    return 0;
+}
+
+int yaml_parse_derive_rng(UrngData *const urng_data, RngData *const rng_data)
+{
+    rng_data->MAX_G_D = rng_data->GROWING_OCT;
+
+    if (rng_data->DIMINISHING_OCT > rng_data->MAX_G_D)
+    {
+        rng_data->MAX_G_D = rng_data->DIMINISHING_OCT;
+    }
+
+    rng_data->EXP_BW = 1 + ceil(log2(rng_data->MAX_G_D));
+    rng_data->SEC_ADDR_SIZE = 1 + ceil(log2(rng_data->GROWING_OCT + rng_data->DIMINISHING_OCT));
+    urng_data->BX = 2 + rng_data->MANT_BW + rng_data->EXP_BW;
 
 
     // TODO: check whether values are valid
     // See Python prototype for some examples of sanity checks
     // E.g. limit K to 48 bits or less (see main.c)
-    if (state.rng_data_addr->MANT_BW <= state.rng_data_addr->K)
+    if (rng_data->MANT_BW <= rng_data->K)
     {
         printf("MANT_BW should be greater than K\n");
-        exit(EXIT_FAILURE);
+        return 1;
     }
     return 0;
 }
@@ -21,13 +21,49 @@ typedef struct
     uint8_t SEC_ADDR_SIZE;
 }RngData;
 
+typedef struct
+{
+    uint8_t BW;   // Number of bits in signed sensor reading/query response
+    int64_t MIN;  // Minimum sensor reading
+    int64_t MAX;  // Maximum sensor reading
+}SensorData;
+
+typedef struct
+{
+    uint8_t DEPTH;          // Number of noise samples held in prefetch FIFO (0 to size automatically)
+    uint8_t BURST_LEN;      // Maximum number of queries in a burst
+    uint8_t QUERY_PERIOD;   // Clock cycles between queries within a burst
+    uint8_t SAMPLE_PERIOD;  // Expected clock cycles between RNG output samples
+    uint8_t ADDR_BW;        // Number of bits used to address FIFO entries
+}FifoData;
+
 /* Parse YAML file, extracting and storing useful information
  *
- * filename  -- path to YAML file
- * urng_data -- pointer to struct to store URNG data within
- * rng_data  -- pointer to struct to store RNG data within
+ * filename    -- path to YAML file
+ * urng_data   -- pointer to struct to store URNG data within
+ * rng_data    -- pointer to struct to store RNG data within
+ * sensor_data -- pointer to struct to store sensor data within
+ * fifo_data   -- pointer to struct to store noise prefetch FIFO data within
+ */
+int yaml_parse_parse(const char *filename, UrngData *const urng_data, RngData *const rng_data,
+                     SensorData *const sensor_data, FifoData *const fifo_data);
+
+/* Calculate derived RNG parameters (EXP_BW, MAX_G_D, SEC_ADDR_SIZE and URNG BX) from RNG data in YAML file
+ *
+ * urng_data -- pointer to URNG data struct to populate
+ * rng_data  -- pointer to RNG data struct, BY, K, MANT_BW, GROWING_OCT and DIMINISHING_OCT must be filled
+ */
+int yaml_parse_derive_rng(UrngData *const urng_data, RngData *const rng_data);
+
+/* Derive SAMPLE_PERIOD (if 0) from RNG latency, then size noise prefetch FIFO (DEPTH and ADDR_BW) for the burst profile
+ *
+ * urng_data -- pointer to URNG data struct, BX must be derived
+ * rng_data  -- pointer to RNG data struct, EXP_BW must be derived
+ * fifo      -- pointer to noise prefetch FIFO data struct from YAML file
+ * use_lut   -- nonzero if the ICDF lookup is combinational logic rather than a ROM (see gen_lookup_use_lut)
  */
-int yaml_parse_parse(const char *filename, UrngData *const urng_data, RngData *const rng_data);
+int yaml_parse_derive_fifo(const UrngData *const urng_data, const RngData *const rng_data, FifoData *const fifo,
+                           int use_lut);
 
 /* Calculate number of sections based on RNG data from YAML file
  *
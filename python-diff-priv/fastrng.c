@@ -0,0 +1,592 @@
+/* Native backend for the differential privacy system prototype
+ *
+ * Bit exact model of the RNG datapath in c_compiler/verilog/rng.v, using the lookup tables generated by the Verilog
+ * compiler (gen_lookup_c0, gen_lookup_c1). The tables are generated once per Model object, then samples are generated
+ * in batches into numpy arrays. test_fastrng.py checks the model against a simulation of rng_core.
+ */
+#define PY_SSIZE_T_CLEAN
+#define NPY_NO_DEPRECATED_API NPY_1_7_API_VERSION
+#include <Python.h>
+#include <numpy/arrayobject.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include "gen_lookup.h"
+#include "yaml_parse.h"
+
+typedef struct
+{
+    UrngData urng_data;
+    RngData rng_data;
+    size_t len;  // Number of lookup table entries
+    by_t *c0;
+    by_t *c1;
+}RngModel;
+
+typedef struct
+{
+    uint64_t s[4];
+}Xoshiro;
+
+static uint64_t rotl(uint64_t x, int k)
+{
+    /* Rotate x left by k bits
+     *
+     * x -- value to rotate
+     * k -- number of bits, 0 < k < 64
+     */
+    return (x << k) | (x >> (64 - k));
+}
+
+static void xoshiro_seed(Xoshiro *state, uint64_t seed)
+{
+    /* Seed xoshiro256** state using splitmix64
+     *
+     * state -- generator state
+     * seed  -- 64 bit seed
+     */
+    for(int i = 0; i < 4; i++)
+    {
+        uint64_t z = (seed += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+        state->s[i] = z ^ (z >> 31);
+    }
+}
+
+static uint64_t xoshiro_next(Xoshiro *state)
+{
+    /* Return next 64 bit xoshiro256** output
+     *
+     * state -- generator state
+     */
+    uint64_t *s = state->s;
+    uint64_t result = rotl(s[1] * 5, 7) * 9;
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+    return result;
+}
+
+static int model_params(UrngData *urng_data, RngData *rng_data, int by, int k, int mant_bw, int growing_oct,
+                        int diminishing_oct)
+{
+    /* Validate RNG parameters and derive the remaining ones as the compiler does, raising a Python exception on failure
+     *
+     * urng_data, rng_data -- parameters to fill in
+     * by, k, mant_bw, growing_oct, diminishing_oct -- RNG parameters, as in privacy.yaml
+     */
+    if(by < 2 || by > 32 || k < 0 || k > 16 || mant_bw <= k || mant_bw > 32 ||
+       growing_oct < 1 || growing_oct > 64 || diminishing_oct < 1 || diminishing_oct > 64)
+    {
+        PyErr_SetString(PyExc_ValueError, "Invalid RNG parameters (require 2 <= by <= 32, 0 <= k <= 16, "
+                                          "k < mant_bw <= 32, 1 <= growing_oct, diminishing_oct <= 64)");
+        return -1;
+    }
+
+    rng_data->BY = (uint8_t)by;
+    rng_data->K = (uint8_t)k;
+    rng_data->MANT_BW = (uint8_t)mant_bw;
+    rng_data->GROWING_OCT = (uint8_t)growing_oct;
+    rng_data->DIMINISHING_OCT = (uint8_t)diminishing_oct;
+    if(yaml_parse_derive_rng(urng_data, rng_data) || urng_data->BX > 63)
+    {
+        PyErr_SetString(PyExc_ValueError, "Invalid RNG parameters");
+        return -1;
+    }
+    return 0;
+}
+
+static int model_init(RngModel *model, int by, int k, int mant_bw, int growing_oct, int diminishing_oct)
+{
+    /* Validate RNG parameters and generate lookup tables, raising a Python exception on failure
+     *
+     * model -- model to initialise
+     * by, k, mant_bw, growing_oct, diminishing_oct -- RNG parameters, as in privacy.yaml
+     */
+    if(model_params(&model->urng_data, &model->rng_data, by, k, mant_bw, growing_oct, diminishing_oct))
+    {
+        return -1;
+    }
+
+    model->len = (size_t)yaml_parse_num_sections(&model->rng_data) * yaml_parse_num_subsections(&model->rng_data);
+    model->c0 = PyMem_Malloc(model->len * sizeof(by_t));
+    model->c1 = PyMem_Malloc(model->len * sizeof(by_t));
+    if(!model->c0 || !model->c1)
+    {
+        PyMem_Free(model->c0);
+        PyMem_Free(model->c1);
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    by_t max_out;
+    gen_lookup_c0(&model->rng_data, model->c0, &max_out);
+    gen_lookup_c1(&model->rng_data, model->c0, max_out, model->c1);
+    return 0;
+}
+
+static void model_free(RngModel *model)
+{
+    /* Free lookup tables allocated by model_init
+     *
+     * model -- initialised model
+     */
+    PyMem_Free(model->c0);
+    PyMem_Free(model->c1);
+}
+
+static int clz(uint64_t val, int num_bits)
+{
+    /* Count leading zeros in the num_bits wide value val
+     *
+     * val      -- value to count leading zeros in
+     * num_bits -- width of val
+     */
+    if(val == 0)
+    {
+        return num_bits;
+    }
+    return __builtin_clzll(val) - (64 - num_bits);
+}
+
+static int64_t model_lookup(const RngModel *model, uint64_t uniform, int exponent)
+{
+    /* Interpolate ICDF from lookup table and apply sign, as in rng
+     *
+     * model    -- RNG model
+     * uniform  -- final uniform random bit vector, supplies symm, part and mantissa bits
+     * exponent -- floating point exponent
+     */
+    const RngData *rng = &model->rng_data;
+    int bx = model->urng_data.BX;
+    int lsb_bits = rng->MANT_BW - rng->K;
+    uint64_t by_mask = (1ULL << rng->BY) - 1;
+
+    uint64_t symm = (uniform >> (bx - 1)) & 1;
+    uint64_t part = (uniform >> (bx - 2)) & 1;
+    uint64_t mant = uniform & ((1ULL << rng->MANT_BW) - 1);
+
+    size_t section = (size_t)exponent + (part ? rng->GROWING_OCT : 0);
+    size_t subsection = (size_t)(mant >> lsb_bits);
+    size_t index = section << rng->K | subsection;
+
+    uint64_t y = (model->c0[index] + model->c1[index] * (mant & ((1ULL << lsb_bits) - 1))) & by_mask;
+    if(symm)
+    {
+        y = (0 - y) & by_mask;
+    }
+
+    // Sign extend BY bit result
+    if(y >> (rng->BY - 1))
+    {
+        y |= ~by_mask;
+    }
+    return (int64_t)y;
+}
+
+static size_t model_generate(const RngModel *model, int64_t (*next)(void *), void *ctx, int64_t *out, size_t n)
+{
+    /* Convert stream of uniform bit vectors to Laplace samples, as in rng_uniform_to_float, returning number of samples
+     *
+     * The exponent is the number of leading zeros in the exponent field, accumulated over re-draws while the field is
+     * zero and capped at the number of octaves in the selected part. The symm, part and mantissa bits come from the
+     * final draw.
+     *
+     * model -- RNG model
+     * next  -- returns the next BX bit uniform random bit vector, or -1 if the stream is exhausted
+     * ctx   -- state passed to next
+     * out   -- buffer to store samples in
+     * n     -- maximum number of samples to generate
+     */
+    const RngData *rng = &model->rng_data;
+    int bx = model->urng_data.BX;
+    uint64_t exp_mask = (1ULL << rng->EXP_BW) - 1;
+
+    for(size_t i = 0; i < n; i++)
+    {
+        int leading_zeros = 0;
+        int max_exp;
+        uint64_t exp_field;
+        int64_t uniform;
+        do
+        {
+            uniform = next(ctx);
+            if(uniform < 0)
+            {
+                return i;
+            }
+            max_exp = ((uniform >> (bx - 2)) & 1) ? rng->DIMINISHING_OCT - 1 : rng->GROWING_OCT - 1;
+            exp_field = ((uint64_t)uniform >> rng->MANT_BW) & exp_mask;
+            leading_zeros += clz(exp_field, rng->EXP_BW);
+        } while(exp_field == 0 && leading_zeros < max_exp);
+
+        int exponent = (leading_zeros < max_exp) ? leading_zeros : max_exp;
+        out[i] = model_lookup(model, (uint64_t)uniform, exponent);
+    }
+    return n;
+}
+
+typedef struct
+{
+    Xoshiro state;
+    int shift;
+}PrngStream;
+
+static int64_t prng_next(void *ctx)
+{
+    /* Return top BX bits of next xoshiro256** output
+     *
+     * ctx -- PrngStream
+     */
+    PrngStream *stream = ctx;
+    return (int64_t)(xoshiro_next(&stream->state) >> stream->shift);
+}
+
+typedef struct
+{
+    const uint64_t *data;
+    size_t len;
+    size_t pos;
+    uint64_t mask;
+}ArrayStream;
+
+static int64_t array_next(void *ctx)
+{
+    /* Return next masked element of array, or -1 if the array is exhausted
+     *
+     * ctx -- ArrayStream
+     */
+    ArrayStream *stream = ctx;
+    if(stream->pos == stream->len)
+    {
+        return -1;
+    }
+    return (int64_t)(stream->data[stream->pos++] & stream->mask);
+}
+
+static PyObject *to_array(const by_t *data, size_t len)
+{
+    /* Return new uint64 numpy array holding a copy of data, or NULL with a Python exception set
+     *
+     * data -- values to copy
+     * len  -- number of values
+     */
+    npy_intp dims[1] = {(npy_intp)len};
+    PyObject *array = PyArray_SimpleNew(1, dims, NPY_UINT64);
+    if(array)
+    {
+        memcpy(PyArray_DATA((PyArrayObject *)array), data, len * sizeof(by_t));
+    }
+    return array;
+}
+
+#define RNG_KWLIST "by", "k", "mant_bw", "growing_oct", "diminishing_oct"
+
+static PyObject *params_dict(const UrngData *urng_data, const RngData *rng_data)
+{
+    /* Return dictionary of parameters derived by the compiler
+     *
+     * urng_data, rng_data -- derived parameters
+     */
+    return Py_BuildValue("{s:i,s:i,s:i,s:i}", "bx", urng_data->BX, "exp_bw", rng_data->EXP_BW,
+                         "max_g_d", rng_data->MAX_G_D, "sec_addr_size", rng_data->SEC_ADDR_SIZE);
+}
+
+PyDoc_STRVAR(params_doc,
+"params(by, k, mant_bw, growing_oct, diminishing_oct) -> dict\n\n"
+"Return the parameters derived by the compiler (bx, exp_bw, max_g_d, sec_addr_size), as written to urng.vh and rng.vh.");
+
+static PyObject *fastrng_params(PyObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {RNG_KWLIST, NULL};
+    int by, k, mant_bw, growing_oct, diminishing_oct;
+    if(!PyArg_ParseTupleAndKeywords(args, kwargs, "iiiii", kwlist, &by, &k, &mant_bw, &growing_oct, &diminishing_oct))
+    {
+        return NULL;
+    }
+
+    UrngData urng_data;
+    RngData rng_data;
+    if(model_params(&urng_data, &rng_data, by, k, mant_bw, growing_oct, diminishing_oct))
+    {
+        return NULL;
+    }
+    return params_dict(&urng_data, &rng_data);
+}
+
+typedef struct
+{
+    PyObject_HEAD
+    RngModel model;
+    int initialised;
+}ModelObject;
+
+static int Model_init(ModelObject *self, PyObject *args, PyObject *kwargs)
+{
+    /* Model.__init__, validate RNG parameters and generate lookup tables
+     *
+     * self         -- Model object
+     * args, kwargs -- by, k, mant_bw, growing_oct, diminishing_oct
+     */
+    static char *kwlist[] = {RNG_KWLIST, NULL};
+    int by, k, mant_bw, growing_oct, diminishing_oct;
+    if(!PyArg_ParseTupleAndKeywords(args, kwargs, "iiiii", kwlist, &by, &k, &mant_bw, &growing_oct, &diminishing_oct))
+    {
+        return -1;
+    }
+
+    // Tables may be in use by another thread with the GIL released, so they are never rebuilt
+    if(self->initialised)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Model is already initialised");
+        return -1;
+    }
+    if(model_init(&self->model, by, k, mant_bw, growing_oct, diminishing_oct))
+    {
+        return -1;
+    }
+    self->initialised = 1;
+    return 0;
+}
+
+static void Model_dealloc(ModelObject *self)
+{
+    /* Free lookup tables and Model object
+     *
+     * self -- Model object
+     */
+    if(self->initialised)
+    {
+        model_free(&self->model);
+    }
+    Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static const RngModel *Model_get(ModelObject *self)
+{
+    /* Return RNG model, or NULL with a Python exception set if Model.__init__ was not called
+     *
+     * self -- Model object
+     */
+    if(!self->initialised)
+    {
+        PyErr_SetString(PyExc_RuntimeError, "Model is not initialised");
+        return NULL;
+    }
+    return &self->model;
+}
+
+PyDoc_STRVAR(Model_params_doc,
+"params() -> dict\n\n"
+"Return the parameters derived by the compiler, as fastrng.params().");
+
+static PyObject *Model_params(ModelObject *self, PyObject *Py_UNUSED(ignored))
+{
+    const RngModel *model = Model_get(self);
+    if(!model)
+    {
+        return NULL;
+    }
+    return params_dict(&model->urng_data, &model->rng_data);
+}
+
+PyDoc_STRVAR(Model_tables_doc,
+"tables() -> (c0, c1)\n\n"
+"Return ICDF lookup table coefficients as uint64 arrays, identical to c0.mem and c1.mem.");
+
+static PyObject *Model_tables(ModelObject *self, PyObject *Py_UNUSED(ignored))
+{
+    const RngModel *model = Model_get(self);
+    if(!model)
+    {
+        return NULL;
+    }
+
+    PyObject *c0 = to_array(model->c0, model->len);
+    PyObject *c1 = to_array(model->c1, model->len);
+    if(!c0 || !c1)
+    {
+        Py_XDECREF(c0);
+        Py_XDECREF(c1);
+        return NULL;
+    }
+    return Py_BuildValue("(NN)", c0, c1);
+}
+
+PyDoc_STRVAR(Model_generate_doc,
+"generate(n, seed=0) -> int64 array\n\n"
+"Return n signed Laplace samples from the RNG datapath model, driven by a seeded xoshiro256** URNG.");
+
+static PyObject *Model_generate(ModelObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"n", "seed", NULL};
+    Py_ssize_t n;
+    unsigned long long seed = 0;
+    if(!PyArg_ParseTupleAndKeywords(args, kwargs, "n|K", kwlist, &n, &seed))
+    {
+        return NULL;
+    }
+    if(n < 0)
+    {
+        PyErr_SetString(PyExc_ValueError, "n must be non-negative");
+        return NULL;
+    }
+
+    const RngModel *model = Model_get(self);
+    if(!model)
+    {
+        return NULL;
+    }
+
+    npy_intp dims[1] = {n};
+    PyObject *array = PyArray_SimpleNew(1, dims, NPY_INT64);
+    if(!array)
+    {
+        return NULL;
+    }
+
+    PrngStream stream;
+    xoshiro_seed(&stream.state, seed);
+    stream.shift = 64 - model->urng_data.BX;
+
+    Py_BEGIN_ALLOW_THREADS
+    model_generate(model, prng_next, &stream, PyArray_DATA((PyArrayObject *)array), (size_t)n);
+    Py_END_ALLOW_THREADS
+
+    return array;
+}
+
+PyDoc_STRVAR(Model_from_uniform_doc,
+"from_uniform(uniform) -> int64 array\n\n"
+"Convert a stream of BX bit uniform random bit vectors (e.g. recorded URNG output) to signed Laplace samples.\n"
+"Re-draws consume further elements of the stream, so fewer samples than len(uniform) may be returned.");
+
+static PyObject *Model_from_uniform(ModelObject *self, PyObject *args, PyObject *kwargs)
+{
+    static char *kwlist[] = {"uniform", NULL};
+    PyObject *uniform_obj;
+    if(!PyArg_ParseTupleAndKeywords(args, kwargs, "O", kwlist, &uniform_obj))
+    {
+        return NULL;
+    }
+
+    const RngModel *model = Model_get(self);
+    if(!model)
+    {
+        return NULL;
+    }
+
+    PyArrayObject *uniform = (PyArrayObject *)PyArray_FROMANY(uniform_obj, NPY_UINT64, 1, 1,
+                                                                  NPY_ARRAY_IN_ARRAY | NPY_ARRAY_FORCECAST);
+    if(!uniform)
+    {
+        return NULL;
+    }
+
+    npy_intp len = PyArray_SIZE(uniform);
+    npy_intp dims[1] = {len};
+    PyObject *array = PyArray_SimpleNew(1, dims, NPY_INT64);
+    if(!array)
+    {
+        Py_DECREF(uniform);
+        return NULL;
+    }
+
+    ArrayStream stream = {
+            .data = PyArray_DATA(uniform),
+            .len = (size_t)len,
+            .pos = 0,
+            .mask = (1ULL << model->urng_data.BX) - 1
+    };
+    size_t count;
+
+    Py_BEGIN_ALLOW_THREADS
+    count = model_generate(model, array_next, &stream, PyArray_DATA((PyArrayObject *)array), (size_t)len);
+    Py_END_ALLOW_THREADS
+
+    Py_DECREF(uniform);
+
+    // Trim to number of complete samples
+    PyArray_Dims new_dims = {dims, 1};
+    dims[0] = (npy_intp)count;
+    PyObject *trimmed = PyArray_Resize((PyArrayObject *)array, &new_dims, 0, NPY_CORDER);
+    if(!trimmed)
+    {
+        Py_DECREF(array);
+        return NULL;
+    }
+    Py_DECREF(trimmed);  // PyArray_Resize returns None
+    return array;
+}
+
+static PyMethodDef Model_methods[] = {
+    {"params", (PyCFunction)Model_params, METH_NOARGS, Model_params_doc},
+    {"tables", (PyCFunction)Model_tables, METH_NOARGS, Model_tables_doc},
+    {"generate", (PyCFunction)(void (*)(void))Model_generate, METH_VARARGS | METH_KEYWORDS, Model_generate_doc},
+    {"from_uniform", (PyCFunction)(void (*)(void))Model_from_uniform, METH_VARARGS | METH_KEYWORDS,
+     Model_from_uniform_doc},
+    {NULL, NULL, 0, NULL}
+};
+
+PyDoc_STRVAR(Model_doc,
+"Model(by, k, mant_bw, growing_oct, diminishing_oct)\n\n"
+"RNG datapath model. Lookup tables are generated once, when the model is created.");
+
+static PyTypeObject ModelType = {
+    PyVarObject_HEAD_INIT(NULL, 0)
+    .tp_name = "fastrng.Model",
+    .tp_doc = Model_doc,
+    .tp_basicsize = sizeof(ModelObject),
+    .tp_itemsize = 0,
+    .tp_flags = Py_TPFLAGS_DEFAULT,
+    .tp_new = PyType_GenericNew,
+    .tp_init = (initproc)Model_init,
+    .tp_dealloc = (destructor)Model_dealloc,
+    .tp_methods = Model_methods,
+};
+
+static PyMethodDef fastrng_methods[] = {
+    {"params", (PyCFunction)(void (*)(void))fastrng_params, METH_VARARGS | METH_KEYWORDS, params_doc},
+    {NULL, NULL, 0, NULL}
+};
+
+static struct PyModuleDef fastrng_module = {
+    PyModuleDef_HEAD_INIT,
+    "fastrng",
+    "Native RNG datapath model sharing lookup tables with the Verilog compiler",
+    -1,
+    fastrng_methods,
+    NULL,
+    NULL,
+    NULL,
+    NULL
+};
+
+PyMODINIT_FUNC PyInit_fastrng(void)
+{
+    import_array();
+    if(PyType_Ready(&ModelType) < 0)
+    {
+        return NULL;
+    }
+
+    PyObject *module = PyModule_Create(&fastrng_module);
+    if(!module)
+    {
+        return NULL;
+    }
+
+    Py_INCREF(&ModelType);
+    if(PyModule_AddObject(module, "Model", (PyObject *)&ModelType) < 0)
+    {
+        Py_DECREF(&ModelType);
+        Py_DECREF(module);
+        return NULL;
+    }
+    return module;
+}
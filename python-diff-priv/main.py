@@ -20,6 +20,11 @@ import numpy as np
 import matplotlib.pyplot as plt
 import math
 
+try:
+    import fastrng  # Native backend, build with 'python setup.py build_ext --inplace'
+except ImportError:
+    fastrng = None
+
 DEBUG = True
 
 
@@ -197,6 +202,7 @@ class Rng:
         self.min_x = 1 / (2 ** (self.growing_oct + 3))
         self.max_x = 0.5 - 1 / (2 ** (self.diminishing_oct + 3))
         self.quantisation_step = (self.laplace_inv_cdf(self.max_x) - self.laplace_inv_cdf(self.min_x)) / 2 ** self.By
+        self._backend = None  # fastrng.Model, see Rng.backend()
 
     def urng(self, bits=None):
         """Return a random number from the URNG.
@@ -243,6 +249,37 @@ class Rng:
 
         return RandFloat(symm != 0, part != 0, exponent, mantissa, self.Bx, self.mant_bw)
 
+    def backend(self):
+        """Return native backend model, creating it (and its lookup tables) on first use.
+        The backend derives Bx from the other parameters as the Verilog compiler does, and must match self.Bx."""
+        if self._backend is None:
+            if fastrng is None:
+                raise ImportError("fastrng native backend not built")
+            model = fastrng.Model(self.By, self.k, self.mant_bw, self.growing_oct, self.diminishing_oct)
+            bx = model.params()['bx']
+            if bx != self.Bx:
+                raise ValueError("fastrng derives Bx = {} from By, k, mant_bw and octaves, but Bx = {}".format(
+                    bx, self.Bx))
+            self._backend = model
+        return self._backend
+
+    def batch(self, n, seed=0):
+        """Return numpy array of n signed Laplace samples from the native RNG datapath model.
+        Lookup tables are generated by the Verilog compiler's gen_lookup_c0/gen_lookup_c1.
+
+        n    -- number of samples
+        seed -- URNG seed
+        """
+        return self.backend().generate(n, seed=seed)
+
+    def batch_from_uniform(self, uniform):
+        """Convert array of URNG outputs to signed Laplace samples using the native RNG datapath model.
+        Re-draws consume further URNG outputs, so fewer samples than len(uniform) may be returned.
+
+        uniform -- numpy array of Bx bit uniform random numbers
+        """
+        return self.backend().from_uniform(uniform)
+
     def get_exponent(self, rbv):
         """Return exponent bits from random bit vector
 
@@ -0,0 +1,24 @@
+"""Build native backend for the differential privacy system prototype
+
+Usage: python setup.py build_ext --inplace
+Requires libyaml and GNU GSL, as for the Verilog compiler (see c_compiler/README.md).
+"""
+
+from setuptools import setup, Extension
+import numpy as np
+
+C_COMPILER_DIR = '../c_compiler'
+
+fastrng = Extension(
+    'fastrng',
+    sources=['fastrng.c',
+             C_COMPILER_DIR + '/gen_lookup.c',
+             C_COMPILER_DIR + '/icdf.c',
+             C_COMPILER_DIR + '/templ.c',
+             C_COMPILER_DIR + '/yaml_parse.c'],
+    include_dirs=[C_COMPILER_DIR, np.get_include()],
+    libraries=['yaml', 'gsl', 'gslcblas', 'm'],
+    extra_compile_args=['-O3'],
+)
+
+setup(name='fastrng', ext_modules=[fastrng])
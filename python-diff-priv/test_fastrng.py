@@ -0,0 +1,156 @@
+"""Cross-check the fastrng native backend against the Verilog RNG datapath
+
+Usage: python -m unittest test_fastrng
+The hardware comparison runs the rng_core_tb.v simulation and is skipped if Icarus Verilog is not installed or the
+iCE40-LVDS-RNG submodule (included by rng.v) is not checked out.
+"""
+
+import os
+import re
+import shutil
+import subprocess
+import unittest
+import numpy as np
+
+try:
+    import fastrng  # Native backend, build with 'python setup.py build_ext --inplace'
+except ImportError:
+    fastrng = None
+
+VERILOG_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'c_compiler', 'verilog')
+URNG_SRC = os.path.join(VERILOG_DIR, '..', '..', 'submodules', 'iCE40-LVDS-RNG', 'uniform_rng.v')
+
+
+def read_defines(*filenames):
+    """Return dictionary of integer `define values from Verilog header files
+
+    filenames -- header file names within VERILOG_DIR
+    """
+    defines = {}
+    for filename in filenames:
+        with open(os.path.join(VERILOG_DIR, filename)) as f:
+            for name, value in re.findall(r'`define\s+(\w+)\s+(\d+)', f.read()):
+                defines[name] = int(value)
+    return defines
+
+
+def tables(model):
+    """Return lookup table coefficients from fastrng model as lists of int
+
+    model -- fastrng.Model
+    """
+    c0, c1 = model.tables()
+    return c0.tolist(), c1.tolist()
+
+
+def read_mem(filename):
+    """Return list of values from hex memory file
+
+    filename -- memory file name within VERILOG_DIR
+    """
+    with open(os.path.join(VERILOG_DIR, filename)) as f:
+        return [int(line, 16) for line in f if line.strip()]
+
+
+def reference(uniform, by, k, mant_bw, growing_oct, diminishing_oct, c0, c1):
+    """Pure Python transliteration of rng_uniform_to_float and the rng_core output stage
+
+    uniform -- sequence of BX bit uniform random numbers
+    by, k, mant_bw, growing_oct, diminishing_oct -- RNG parameters, as in privacy.yaml
+    c0, c1  -- lookup table coefficients, as lists of int
+    """
+    params = fastrng.params(by, k, mant_bw, growing_oct, diminishing_oct)
+    bx, exp_bw = params['bx'], params['exp_bw']
+    lsb_bw = mant_bw - k
+    by_mask = 2**by - 1
+
+    samples = []
+    exponent = 0  # Exponent accumulator, carried over re-draws
+    for u in uniform:
+        symm = (u >> (bx - 1)) & 1
+        part = (u >> (bx - 2)) & 1
+        max_exp = (diminishing_oct if part else growing_oct) - 1
+        exp_part = (u >> mant_bw) & (2**exp_bw - 1)
+        leading_zeros = exp_bw - exp_part.bit_length()
+
+        if exponent + leading_zeros >= max_exp:
+            exponent = max_exp
+        else:
+            exponent += leading_zeros
+            if exp_part == 0:
+                continue  # Re-draw
+
+        mant = u & (2**mant_bw - 1)
+        addr = ((exponent + (growing_oct if part else 0)) << k) | (mant >> lsb_bw)
+        y = (c0[addr] + c1[addr] * (mant & (2**lsb_bw - 1))) & by_mask
+        if symm:
+            y = -y & by_mask
+        samples.append(y - 2**by if y >> (by - 1) else y)
+        exponent = 0
+    return samples
+
+
+@unittest.skipIf(fastrng is None, "fastrng native backend not built")
+class TestFastrng(unittest.TestCase):
+    def setUp(self):
+        defines = read_defines('urng.vh', 'rng.vh')
+        self.bx = defines['URNG_BX']
+        self.rng_params = (defines['RNG_BY'], defines['RNG_K'], defines['RNG_MANT_BW'],
+                           defines['RNG_GROWING_OCT'], defines['RNG_DIMINISHING_OCT'])
+        self.model = fastrng.Model(*self.rng_params)
+
+    def test_params(self):
+        self.assertEqual(fastrng.params(*self.rng_params)['bx'], self.bx)
+        self.assertEqual(self.model.params(), fastrng.params(*self.rng_params))
+
+    def test_tables(self):
+        c0, c1 = tables(self.model)
+        self.assertEqual(c0, read_mem('c0.mem'))
+        self.assertEqual(c1, read_mem('c1.mem'))
+
+    def test_max_exponent(self):
+        # First draw reaches max_exp with a zero exponent part, so it is not re-drawn
+        self.assertEqual(fastrng.Model(16, 2, 3, 4, 3).from_uniform([135, 255]).tolist(), [-19874, -1356])
+
+    def test_two_draws(self):
+        # Every pair of draws, covering each re-draw and max_exp case for the shipped configuration
+        c0, c1 = tables(self.model)
+        for first in range(2**self.bx):
+            for second in range(2**self.bx):
+                uniform = [first, second]
+                self.assertEqual(self.model.from_uniform(uniform).tolist(),
+                                 reference(uniform, *self.rng_params, c0, c1), uniform)
+
+    def test_generate(self):
+        # Seeded batches are reproducible
+        self.assertEqual(self.model.generate(1000, seed=3).tolist(), self.model.generate(1000, seed=3).tolist())
+
+    def test_redraws(self):
+        # More growing octaves than exponent bits, so zero exponent parts are re-drawn
+        rng_params = (16, 2, 3, 8, 3)
+        model = fastrng.Model(*rng_params)
+        c0, c1 = tables(model)
+        uniform = np.random.default_rng(1).integers(0, 2**model.params()['bx'], 20000).tolist()
+        samples = model.from_uniform(uniform).tolist()
+        self.assertLess(len(samples), len(uniform))
+        self.assertTrue(samples == reference(uniform, *rng_params, c0, c1))
+
+    @unittest.skipIf(shutil.which('iverilog') is None, "Icarus Verilog not installed")
+    @unittest.skipIf(not os.path.exists(URNG_SRC), "iCE40-LVDS-RNG submodule not checked out")
+    def test_hardware(self):
+        # Simulate rng_core with recorded uniform random numbers and compare every transferred sample
+        uniform = np.random.default_rng(2).integers(0, 2**self.bx, 4096).tolist()
+        os.makedirs(os.path.join(VERILOG_DIR, 'sim'), exist_ok=True)
+        with open(os.path.join(VERILOG_DIR, 'sim', 'uniform.mem'), 'w') as f:
+            f.writelines('{:x}\n'.format(u) for u in uniform)
+        subprocess.run(['make', 'simrngcore'], cwd=VERILOG_DIR, check=True, stdout=subprocess.DEVNULL)
+        with open(os.path.join(VERILOG_DIR, 'sim', 'rng_core.out')) as f:
+            hardware = [int(line) for line in f if line.strip()]
+
+        samples = self.model.from_uniform(uniform).tolist()
+        self.assertEqual(len(hardware), len(samples))
+        self.assertTrue(hardware == samples)
+
+
+if __name__ == '__main__':
+    unittest.main()